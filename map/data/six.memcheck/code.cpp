@@ -0,0 +1,148 @@
+#include "map.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+unsigned long long seed = 998244353;
+
+unsigned long long next()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+// a stream over s that cannot seek, like a pipe.
+struct pipe_buf : std::streambuf {
+	std::string data;
+
+	explicit pipe_buf(const std::string &s) : data(s) {
+		setg(&data[0], &data[0], &data[0] + data.size());
+	}
+};
+
+void TestRoundTrip()
+{
+	std::cout << "Testing save and load..." << std::endl;
+	sjtu::map<int, std::string> m;
+	std::map<int, std::string> ref;
+	for (int i = 0; i < 100000; ++i) {
+		int key = int(next() % 1000000);
+		std::string value = std::to_string(key * 3);
+		m.insert(sjtu::pair<const int, std::string>(key, value));
+		ref[key] = value;
+	}
+	std::stringstream ss;
+	m.save(ss);
+	sjtu::map<int, std::string> loaded;
+	loaded.insert(sjtu::pair<const int, std::string>(-1, "gone"));
+	loaded.load(ss);
+	bool ok = loaded.size() == ref.size() && loaded.count(-1) == 0;
+	for (auto it = ref.begin(); it != ref.end(); ++it) {
+		ok = ok && loaded.at(it->first) == it->second;
+	}
+	auto r = ref.begin();
+	size_t visited = 0;
+	for (sjtu::map<int, std::string>::const_iterator it = loaded.cbegin(); it != loaded.cend(); ++it, ++r, ++visited) {
+		ok = ok && it->first == r->first && it->second == r->second;
+	}
+	std::cout << loaded.size() << " " << visited << " " << ok << std::endl;
+	for (int i = 0; i < 1000; ++i) {
+		loaded.insert(sjtu::pair<const int, std::string>(1000000 + i, "new"));
+	}
+	std::cout << loaded.size() << " " << loaded.at(1000999) << " " << loaded.count(1000500) << std::endl;
+}
+
+void TestRawKeys()
+{
+	std::cout << "Testing trivially copyable keys and values..." << std::endl;
+	sjtu::map<long long, double> m;
+	for (long long i = 1; i <= 1000; ++i) {
+		m.insert(sjtu::pair<const long long, double>(i * i, i * 0.5));
+	}
+	std::stringstream ss;
+	m.save(ss);
+	std::cout << ss.str().size() << std::endl;
+	sjtu::map<long long, double> loaded;
+	loaded.load(ss);
+	std::cout << loaded.size() << " " << loaded.at(250000) << " " << loaded.at(1000000) << std::endl;
+	sjtu::map<long long, double> empty, emptyLoaded;
+	std::stringstream se;
+	empty.save(se);
+	emptyLoaded.load(se);
+	std::cout << emptyLoaded.size() << " " << emptyLoaded.empty() << std::endl;
+}
+
+void TestErrors()
+{
+	std::cout << "Testing bad snapshots..." << std::endl;
+	sjtu::map<int, int> m;
+	for (int i = 0; i < 10; ++i) {
+		m.insert(sjtu::pair<const int, int>(i, i));
+	}
+	std::stringstream ss;
+	m.save(ss);
+	std::string bytes = ss.str();
+	sjtu::map<int, int> target;
+	target.insert(sjtu::pair<const int, int>(7, 77));
+	sjtu::map<int, long long> wrong;
+	std::stringstream s1(bytes);
+	try {
+		wrong.load(s1);
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	std::stringstream s2(bytes.substr(0, bytes.size() - 3));
+	try {
+		target.load(s2);
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	// swapping two records breaks the key order.
+	std::string shuffled = bytes;
+	for (int i = 0; i < 8; ++i) {
+		std::swap(shuffled[24 + i], shuffled[32 + i]);
+	}
+	std::stringstream s3(shuffled);
+	try {
+		target.load(s3);
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	// counts that do not fit in memory or in the stream.
+	std::string huge = bytes;
+	std::uint64_t n = (std::uint64_t(1) << 61) + 1;
+	std::memcpy(&huge[16], &n, sizeof(n));
+	std::stringstream s4(huge);
+	try {
+		target.load(s4);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "runtime_error thrown" << std::endl;
+	}
+	pipe_buf pb(huge);
+	std::istream s5(&pb);
+	try {
+		target.load(s5);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "runtime_error thrown" << std::endl;
+	}
+	std::cout << target.size() << " " << target.at(7) << std::endl;
+	pipe_buf pb2(bytes);
+	std::istream s6(&pb2);
+	target.load(s6);
+	std::cout << target.size() << " " << target.at(7) << std::endl;
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestRawKeys();
+	TestErrors();
+	return 0;
+}
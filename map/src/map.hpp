@@ -7,8 +7,10 @@
 // only for std::less<T>
 #include <functional>
 #include <cstddef>
+#include <iostream>
 #include "utility.hpp"
 #include "exceptions.hpp"
+#include "serialize.hpp"
 
 namespace sjtu {
 
@@ -191,6 +193,26 @@ namespace sjtu {
             return tmp;
         }
 
+        // links nodes[from, to), sorted by key, into a balanced tree under parent.
+        node *buildSorted(node **nodes, size_t from, size_t to, node *parent) {
+            if (from == to) return nullptr;
+            size_t mid = from + (to - from) / 2;
+            node *t = nodes[mid];
+            t->parent = parent;
+            t->left = buildSorted(nodes, from, mid, t);
+            t->right = buildSorted(nodes, mid + 1, to, t);
+            t->height = max(height(t->left), height(t->right)) + 1;
+            return t;
+        }
+
+        void saveTree(std::ostream &os, const node *t) const {
+            if (t == nullptr) return;
+            saveTree(os, t->left);
+            serializer<Key>::save(os, (*t->data)->first);
+            serializer<T>::save(os, (*t->data)->second);
+            saveTree(os, t->right);
+        }
+
         node *search(node *t, const Key &key) {
             if (t == nullptr)
                 return nullptr;//throw index_out_of_bound();
@@ -687,6 +709,59 @@ namespace sjtu {
         }
 
         const_iterator find(const Key &key) const {}
+
+        /**
+         * writes a binary snapshot of the elements to os in key order; see serialize.hpp.
+         * throw runtime_error if os fails.
+         */
+        void save(std::ostream &os) const {
+            snapshot_header('M', snapshot_size<Key>(), snapshot_size<T>(), size1).save(os);
+            saveTree(os, root);
+        }
+
+        /**
+         * replaces the elements with those of a snapshot written by save.
+         * the keys arrive sorted, so the tree is linked bottom-up in O(n)
+         * instead of n insertions.
+         * throw runtime_error if is does not hold such a snapshot or its keys are
+         * out of order; the map is left unchanged then.
+         */
+        void load(std::istream &is) {
+            size_t n = snapshot_count(is, snapshot_header::load(is, snapshot_header('M', snapshot_size<Key>(),
+                                                                                    snapshot_size<T>(), 0)),
+                                      size_t(snapshot_size<Key>()) + snapshot_size<T>());
+            // n is only trusted as far as the stream goes, so the table of nodes
+            // grows while they are read instead of being sized up front.
+            size_t cap = 16;
+            node **nodes = new node *[cap];
+            size_t made = 0;
+            try {
+                while (made < n) {
+                    Key key = serializer<Key>::load(is);
+                    T value = serializer<T>::load(is);
+                    if (made == cap) {
+                        node **more = new node *[cap * 2];
+                        for (size_t i = 0; i < made; ++i) more[i] = nodes[i];
+                        delete[] nodes;
+                        nodes = more;
+                        cap *= 2;
+                    }
+                    nodes[made++] = new node(value_type(key, value));
+                    if (made > 1 && !Compare()((*nodes[made - 2]->data)->first, (*nodes[made - 1]->data)->first)) {
+                        throw runtime_error();
+                    }
+                }
+            } catch (...) {
+                for (size_t i = 0; i < made; ++i) delete nodes[i];
+                delete[] nodes;
+                throw;
+            }
+            node *t = buildSorted(nodes, 0, n, nullptr);
+            delete[] nodes;
+            clear();
+            root = t;
+            size1 = n;
+        }
     };
 
 }
@@ -0,0 +1,63 @@
+/**
+ * times building a queue of 10M random ints with n pushes against the range
+ * constructor, which builds the heap bottom-up, for each backend.
+ * both include the first pop: a pairing heap defers the work of n pushes to it.
+ *
+ *   g++ -std=c++17 -O2 -I ../src build.cpp -o build && ./build
+ */
+#include "priority_queue.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+template<class F>
+double Time(F f)
+{
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double, std::milli> d = std::chrono::steady_clock::now() - start;
+	return d.count();
+}
+
+unsigned long long seed = 88172645463325252ull;
+
+int Next()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return int(seed >> 33);
+}
+
+volatile int sink;
+
+template<class Heap>
+void Run(const char *name, const std::vector<int> &values)
+{
+	typedef sjtu::priority_queue<int, std::less<int>, Heap> queue;
+	double push = Time([&] {
+		queue pq;
+		for (int x : values) pq.push(x);
+		pq.pop();
+		sink = pq.top();
+	});
+	double range = Time([&] {
+		queue pq(values.begin(), values.end());
+		pq.pop();
+		sink = pq.top();
+	});
+	std::printf("%-10s %10.1f ms %10.1f ms\n", name, push, range);
+}
+
+int main()
+{
+	std::vector<int> values(10000000);
+	for (int &x : values) x = Next();
+	std::printf("%-10s %13s %13s\n", "heap", "pushes", "range");
+	Run<sjtu::leftist_heap>("leftist", values);
+	Run<sjtu::pairing_heap>("pairing", values);
+	Run<sjtu::dary_heap<4>>("4-ary", values);
+	return 0;
+}
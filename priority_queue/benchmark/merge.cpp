@@ -0,0 +1,179 @@
+/**
+ * times the priority_queue backends against the original recursive leftist
+ * heap on the 400k + 400k merge of data/five.
+ *
+ *   g++ -std=c++17 -O2 -I ../src merge.cpp -o merge && ./merge
+ *
+ * the recursive heap below is the original implementation, kept only here:
+ * it recurses in merge, copy and clear and allocates every node and every
+ * element separately, where priority_queue loops and takes nodes with their
+ * elements inline from its node_pool.
+ * each heap runs in a fresh process, so that none inherits the free lists
+ * that another left behind in the memory allocator.
+ */
+#include "priority_queue.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace recursive {
+    template<typename T, class Compare = std::less<T>>
+    class heap {
+    public:
+        heap() : root(nullptr) {}
+
+        heap(const heap &other) : root(build(other.root)) {}
+
+        ~heap() {
+            clear(root);
+        }
+
+        void push(const T &e) {
+            node *p = new node;
+            p->data = new T(e);
+            root = merge(p, root);
+        }
+
+        const T &top() const {
+            return *root->data;
+        }
+
+        void pop() {
+            node *t = root;
+            root = merge(root->left, root->right);
+            delete t;
+        }
+
+        void merge(heap &other) {
+            root = merge(root, other.root);
+            other.root = nullptr;
+        }
+
+    private:
+        struct node {
+            T *data = nullptr;
+            node *left = nullptr, *right = nullptr;
+            int npl = 0;
+
+            ~node() {
+                delete data;
+            }
+        };
+
+        node *root;
+
+        static node *merge(node *l, node *r) {
+            if (l == nullptr) return r;
+            if (r == nullptr) return l;
+            return !Compare()(*l->data, *r->data) ? merge1(l, r) : merge1(r, l);
+        }
+
+        static node *merge1(node *l, node *r) {
+            if (l->left == nullptr) {
+                l->left = r;
+            } else {
+                l->right = merge(l->right, r);
+                if (l->left->npl < l->right->npl) std::swap(l->left, l->right);
+                l->npl = l->right->npl + 1;
+            }
+            return l;
+        }
+
+        static node *build(const node *other) {
+            if (other == nullptr) return nullptr;
+            node *t = new node;
+            t->data = new T(*other->data);
+            t->npl = other->npl;
+            t->left = build(other->left);
+            t->right = build(other->right);
+            return t;
+        }
+
+        static void clear(node *t) {
+            if (t == nullptr) return;
+            clear(t->left);
+            clear(t->right);
+            delete t;
+        }
+    };
+}
+
+template<class F>
+double Time(F f)
+{
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double, std::milli> d = std::chrono::steady_clock::now() - start;
+	return d.count();
+}
+
+// the generator of data/five.
+int Next()
+{
+	static unsigned reed = 1727417277u;
+	reed += (reed << 5) + 172741827u;
+	return int(reed);
+}
+
+volatile long long sink;
+
+template<class Heap>
+void Run(const char *name, const int *values, int n)
+{
+	Heap a, b;
+	double push = Time([&] {
+		for (int i = 0; i < n; ++i) a.push(values[i]);
+		for (int i = n; i < 2 * n; ++i) b.push(values[i]);
+	});
+	double merge = Time([&] { a.merge(b); });
+	double copy = 0, clear = 0;
+	{
+		Heap *c = nullptr;
+		copy = Time([&] { c = new Heap(a); });
+		clear = Time([&] { delete c; });
+	}
+	double pop = Time([&] {
+		long long s = 0;
+		for (int i = 0; i < 2 * n; ++i) {
+			s += a.top();
+			a.pop();
+		}
+		sink = s;
+	});
+	std::printf("%-10s %9.1f ms %9.3f ms %9.1f ms %9.1f ms %9.1f ms\n", name, push, merge, copy, clear, pop);
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc == 1) {
+		std::printf("%-10s %12s %12s %12s %12s %12s\n", "heap", "push", "merge", "copy", "clear", "pop");
+		for (const char *keys : {"random", "increasing"}) {
+			std::printf("%s keys, 400000 + 400000\n", keys);
+			for (const char *heap : {"recursive", "leftist", "pairing", "4-ary"}) {
+				std::fflush(stdout);
+				if (std::system((std::string(argv[0]) + " " + keys + " " + heap).c_str()) != 0) return 1;
+			}
+		}
+		return 0;
+	}
+	const int n = 400000;
+	static int values[2 * n];
+	for (int i = 0; i < 2 * n; ++i) {
+		// increasing keys pile every old root onto the left spine.
+		values[i] = std::strcmp(argv[1], "random") == 0 ? Next() : i < n ? i : -i;
+	}
+	if (std::strcmp(argv[2], "recursive") == 0) {
+		Run<recursive::heap<int>>("recursive", values, n);
+	} else if (std::strcmp(argv[2], "pairing") == 0) {
+		Run<sjtu::priority_queue<int, std::less<int>, sjtu::pairing_heap>>("pairing", values, n);
+	} else if (std::strcmp(argv[2], "4-ary") == 0) {
+		Run<sjtu::priority_queue<int, std::less<int>, sjtu::dary_heap<4>>>("4-ary", values, n);
+	} else {
+		Run<sjtu::priority_queue<int>>("leftist", values, n);
+	}
+	return 0;
+}
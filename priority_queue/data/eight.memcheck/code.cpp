@@ -0,0 +1,97 @@
+#include "priority_queue.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+long long allocations = 0;
+
+void *operator new(size_t n)
+{
+	++allocations;
+	if (void *p = std::malloc(n != 0 ? n : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+unsigned long long seed = 20240601;
+
+unsigned long long next()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+// an event scheduler: a queue that stays about the same size while events come and go.
+void TestSteadyState()
+{
+	std::cout << "Testing steady state..." << std::endl;
+	sjtu::priority_queue<long long, std::greater<long long>> events;
+	for (int i = 0; i < 10000; ++i) {
+		events.push((long long) (next() % 1000000));
+	}
+	long long before = allocations, now = 0;
+	for (int i = 0; i < 1000000; ++i) {
+		now = events.top();
+		events.pop();
+		events.push(now + (long long) (next() % 1000));
+	}
+	std::cout << events.size() << " " << (allocations - before) << " " << (events.top() >= now) << std::endl;
+}
+
+void TestMerge()
+{
+	std::cout << "Testing merges..." << std::endl;
+	sjtu::priority_queue<std::string> a;
+	{
+		sjtu::priority_queue<std::string> b;
+		for (int i = 0; i < 3000; ++i) {
+			a.push(std::to_string(next() % 100000));
+			b.push(std::to_string(next() % 100000));
+		}
+		a.merge(b);
+		b.push("only in b");
+		std::cout << a.size() << " " << b.size() << " " << b.top() << std::endl;
+	}
+	sjtu::priority_queue<std::string> c(a);
+	for (int i = 0; i < 1000; ++i) {
+		c.pop();
+	}
+	sjtu::priority_queue<std::string> d;
+	d = c;
+	std::string last = d.top();
+	bool ok = true;
+	size_t n = 0;
+	while (!d.empty()) {
+		ok = ok && !(last < d.top());
+		last = d.top();
+		d.pop();
+		++n;
+	}
+	std::cout << a.size() << " " << c.size() << " " << n << ok << std::endl;
+	// the emptied queue keeps its slots and refills without a new slab.
+	long long before = allocations;
+	for (int i = 0; i < 5000; ++i) {
+		d.push("x");
+	}
+	std::cout << (allocations - before) << " " << d.size() << std::endl;
+}
+
+int main()
+{
+	TestSteadyState();
+	TestMerge();
+	return 0;
+}
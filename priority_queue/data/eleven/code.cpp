@@ -0,0 +1,166 @@
+#include "priority_queue.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+
+unsigned long long seed = 20250317;
+
+unsigned long long next()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed >> 16;
+}
+
+long long comparisons = 0;
+long long budget = -1;
+
+struct Counting {
+	bool operator()(int a, int b) const {
+		++comparisons;
+		if (budget >= 0 && budget-- == 0) throw 0;
+		return a < b;
+	}
+};
+
+int copies = -1;
+
+// an element whose copy constructor throws once copies runs out.
+struct Fragile {
+	int x;
+
+	Fragile(int x) : x(x) {}
+
+	Fragile(const Fragile &other) : x(other.x) {
+		if (copies >= 0 && copies-- == 0) throw std::string("copy failed");
+	}
+
+	Fragile &operator=(const Fragile &other) = default;
+
+	bool operator<(const Fragile &other) const {
+		return x < other.x;
+	}
+};
+
+template<class Q>
+bool Drains(Q &q, std::vector<int> sorted)
+{
+	std::sort(sorted.begin(), sorted.end());
+	bool ok = q.size() == sorted.size();
+	while (ok && !q.empty()) {
+		ok = q.top() == sorted.back();
+		sorted.pop_back();
+		q.pop();
+	}
+	return ok && q.empty();
+}
+
+// building from a range takes a linear number of comparisons.
+template<class Heap>
+bool Build()
+{
+	const int n = 1000000;
+	std::vector<int> values(n);
+	for (int &x : values) {
+		x = int(next() % 100000000);
+	}
+	comparisons = 0;
+	sjtu::priority_queue<int, Counting, Heap> pq(values.begin(), values.end());
+	bool ok = comparisons < 3LL * n;
+	std::list<int> more;
+	for (int i = 0; i < 1000; ++i) {
+		more.push_back(int(next() % 100000000));
+		values.push_back(more.back());
+	}
+	comparisons = 0;
+	pq.push_range(more.begin(), more.end());
+	ok = ok && comparisons < 3000 + 1000 * 64;
+	sjtu::priority_queue<int, Counting, Heap> empty(more.end(), more.end());
+	empty.push_range(values.end(), values.end());
+	return ok && empty.empty() && Drains(pq, values);
+}
+
+// a throwing copy or comparison leaves the queue as it was.
+template<class Heap>
+bool Throwing()
+{
+	std::vector<int> values;
+	std::vector<Fragile> range;
+	sjtu::priority_queue<Fragile, std::less<Fragile>, Heap> pq;
+	for (int i = 0; i < 1000; ++i) {
+		values.push_back(int(next() % 1000));
+		pq.push(values.back());
+	}
+	for (int i = 0; i < 500; ++i) {
+		range.push_back(int(next() % 1000));
+	}
+	copies = 300;
+	try {
+		pq.push_range(range.begin(), range.end());
+		return false;
+	} catch (std::string &) {
+	}
+	copies = -1;
+	sjtu::priority_queue<Fragile, std::less<Fragile>, Heap> copy(pq);
+	std::vector<int> sorted = values;
+	std::sort(sorted.begin(), sorted.end());
+	bool ok = copy.size() == sorted.size();
+	while (ok && !copy.empty()) {
+		ok = copy.top().x == sorted.back();
+		sorted.pop_back();
+		copy.pop();
+	}
+	return ok;
+}
+
+// with node-based heaps a comparison that throws while building or merging changes nothing either.
+template<class Heap>
+bool ThrowingCompare()
+{
+	std::vector<int> values, range;
+	sjtu::priority_queue<int, Counting, Heap> pq;
+	for (int i = 0; i < 1000; ++i) {
+		values.push_back(int(next() % 1000));
+		pq.push(values.back());
+	}
+	for (int i = 0; i < 500; ++i) {
+		range.push_back(int(next() % 1000));
+	}
+	bool ok = false;
+	for (long long b = 0; b < 5000; b += 37) {
+		budget = b;
+		try {
+			pq.push_range(range.begin(), range.end());
+			budget = -1;
+			ok = true;
+			break;
+		} catch (int) {
+			budget = -1;
+			if (pq.size() != values.size()) return false;
+		}
+	}
+	values.insert(values.end(), range.begin(), range.end());
+	return ok && Drains(pq, values);
+}
+
+int main()
+{
+	std::cout << Build<sjtu::leftist_heap>() << Build<sjtu::pairing_heap>() << Build<sjtu::dary_heap<>>()
+	          << Build<sjtu::dary_heap<2>>() << std::endl;
+	std::cout << Throwing<sjtu::leftist_heap>() << Throwing<sjtu::pairing_heap>() << Throwing<sjtu::dary_heap<>>()
+	          << std::endl;
+	std::cout << ThrowingCompare<sjtu::leftist_heap>() << ThrowingCompare<sjtu::pairing_heap>() << std::endl;
+	int raw[] = {5, 1, 4, 1, 5, 9, 2, 6};
+	sjtu::priority_queue<int> pq(raw, raw + 8);
+	while (!pq.empty()) {
+		std::cout << pq.top() << " ";
+		pq.pop();
+	}
+	std::cout << std::endl;
+	return 0;
+}
@@ -0,0 +1,239 @@
+#include "priority_queue.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+unsigned long long seed = 998244353;
+
+unsigned long long next()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+int comparisons = -1;
+
+struct Touchy {
+	bool operator()(const std::string &a, const std::string &b) const {
+		if (comparisons >= 0 && comparisons-- == 0) throw 0;
+		return a < b;
+	}
+};
+
+// random pushes, pops, copies and merges, checked against std::priority_queue.
+template<class Heap>
+bool Random()
+{
+	sjtu::priority_queue<int, std::greater<int>, Heap> heaps[4];
+	std::priority_queue<int, std::vector<int>, std::greater<int>> ref[4];
+	bool ok = true;
+	seed = 998244353;
+	for (int round = 0; round < 60000; ++round) {
+		size_t a = (next() >> 32) % 4, b = (next() >> 32) % 4;
+		switch ((next() >> 32) % 8) {
+			case 0:
+			case 1:
+			case 2:
+			case 3: {
+				int x = int(next() % 100000);
+				heaps[a].push(x);
+				ref[a].push(x);
+				break;
+			}
+			case 4:
+			case 5:
+				if (!ref[a].empty()) {
+					ok = ok && heaps[a].top() == ref[a].top();
+					heaps[a].pop();
+					ref[a].pop();
+				}
+				break;
+			case 6:
+				if (a == b) break;
+				heaps[a].merge(heaps[b]);
+				while (!ref[b].empty()) {
+					ref[a].push(ref[b].top());
+					ref[b].pop();
+				}
+				break;
+			default:
+				if ((next() >> 32) % 64 == 0) {
+					heaps[b] = heaps[a];
+					ref[b] = ref[a];
+				}
+		}
+	}
+	for (int i = 0; i < 4; ++i) {
+		sjtu::priority_queue<int, std::greater<int>, Heap> copy(heaps[i]);
+		ok = ok && copy.size() == ref[i].size();
+		while (!ref[i].empty()) {
+			ok = ok && copy.top() == ref[i].top();
+			copy.pop();
+			ref[i].pop();
+		}
+		ok = ok && copy.empty();
+	}
+	return ok;
+}
+
+// increasing keys make a long left spine, a root with n children or a deep array.
+template<class Heap>
+bool Skewed()
+{
+	const int n = 1000000;
+	sjtu::priority_queue<int, std::less<int>, Heap> pq;
+	for (int i = 0; i < n; ++i) {
+		pq.push(i);
+	}
+	sjtu::priority_queue<int, std::less<int>, Heap> copy(pq);
+	bool ok = copy.size() == size_t(n);
+	for (int i = n - 1; i >= 0; --i) {
+		ok = ok && pq.top() == i;
+		pq.pop();
+	}
+	return ok && pq.empty() && copy.top() == n - 1;
+}
+
+// a throwing comparison leaves push and pop without effect and merge without loss.
+template<class Heap>
+bool Throwing()
+{
+	sjtu::priority_queue<std::string, Touchy, Heap> a, b;
+	comparisons = -1;
+	for (int i = 0; i < 2000; ++i) {
+		a.push(std::to_string(next() % 100000));
+		b.push(std::to_string(next() % 100000));
+	}
+	bool ok = true;
+	for (int budget = 0; budget < 40; ++budget) {
+		std::string before = a.top();
+		size_t size = a.size();
+		comparisons = budget;
+		try {
+			a.push(std::to_string(next() % 100000));
+			comparisons = -1;
+			++size;
+		} catch (const sjtu::runtime_error &) {
+			comparisons = -1;
+		}
+		ok = ok && a.size() == size && !(a.top() < before);
+		before = a.top();
+		comparisons = budget;
+		try {
+			a.pop();
+			comparisons = -1;
+			--size;
+		} catch (int) {
+			comparisons = -1;
+			ok = ok && a.top() == before;
+		}
+		ok = ok && a.size() == size;
+	}
+	size_t total = a.size() + b.size();
+	comparisons = 7;
+	try {
+		a.merge(b);
+	} catch (int) {
+	}
+	comparisons = -1;
+	if (!b.empty()) a.merge(b);
+	std::string last = "~";
+	size_t n = 0;
+	while (!a.empty()) {
+		ok = ok && !(last < a.top());
+		last = a.top();
+		a.pop();
+		++n;
+	}
+	return ok && n == total;
+}
+
+// snapshots do not depend on the backend that wrote them.
+template<class From, class To>
+bool Snapshot()
+{
+	sjtu::priority_queue<std::string, std::less<std::string>, From> a;
+	for (int i = 0; i < 5000; ++i) {
+		a.push(std::to_string(next() % 100000));
+	}
+	std::stringstream ss;
+	a.save(ss);
+	sjtu::priority_queue<std::string, std::less<std::string>, To> b;
+	b.push("stale");
+	b.load(ss);
+	bool ok = a.size() == b.size();
+	while (!a.empty()) {
+		ok = ok && a.top() == b.top();
+		a.pop();
+		b.pop();
+	}
+	return ok && b.empty();
+}
+
+// a stream over s that cannot seek, like a pipe.
+struct pipe_buf : std::streambuf {
+	std::string data;
+
+	explicit pipe_buf(const std::string &s) : data(s) {
+		setg(&data[0], &data[0], &data[0] + data.size());
+	}
+};
+
+// snapshots whose count does not fit in memory or in the stream are refused.
+template<class Heap>
+bool HugeCount()
+{
+	sjtu::priority_queue<long long, std::less<long long>, Heap> a;
+	a.push(5);
+	std::stringstream ss;
+	a.save(ss);
+	std::string bytes = ss.str();
+	bool ok = true;
+	const std::uint64_t counts[] = {(std::uint64_t(1) << 61) + 1, 1000000};
+	for (std::uint64_t n : counts) {
+		std::string huge = bytes;
+		std::memcpy(&huge[16], &n, sizeof(n));
+		std::stringstream s1(huge);
+		pipe_buf pb(huge);
+		std::istream s2(&pb);
+		std::istream *streams[] = {&s1, &s2};
+		for (std::istream *s : streams) {
+			bool thrown = false;
+			try {
+				a.load(*s);
+			} catch (const sjtu::runtime_error &) {
+				thrown = true;
+			}
+			ok = ok && thrown && a.size() == 1 && a.top() == 5;
+		}
+	}
+	return ok;
+}
+
+template<class Heap>
+void Test(const char *name)
+{
+	std::cout << name << " " << Random<Heap>() << Skewed<Heap>() << Throwing<Heap>() << HugeCount<Heap>() << std::endl;
+}
+
+int main()
+{
+	Test<sjtu::leftist_heap>("leftist");
+	Test<sjtu::pairing_heap>("pairing");
+	Test<sjtu::dary_heap<>>("4-ary");
+	Test<sjtu::dary_heap<2>>("binary");
+	Test<sjtu::dary_heap<8>>("8-ary");
+	std::cout << Snapshot<sjtu::leftist_heap, sjtu::pairing_heap>()
+	          << Snapshot<sjtu::pairing_heap, sjtu::dary_heap<>>()
+	          << Snapshot<sjtu::dary_heap<3>, sjtu::leftist_heap>() << std::endl;
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include "priority_queue.hpp"
+
+#include <iostream>
+#include <string>
+
+unsigned long long seed = 1000000007;
+
+unsigned long long next()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+// pushing in increasing order puts every old root on the left spine, one level deeper.
+void TestSkewed()
+{
+	std::cout << "Testing skewed heaps..." << std::endl;
+	const int n = 2000000;
+	sjtu::priority_queue<int> pq;
+	for (int i = 0; i < n; ++i) {
+		pq.push(i);
+	}
+	sjtu::priority_queue<int> copy(pq);
+	sjtu::priority_queue<int> assigned;
+	assigned.push(-1);
+	assigned = copy;
+	std::cout << copy.size() << " " << copy.top() << " " << assigned.size() << " " << assigned.top() << std::endl;
+	sjtu::priority_queue<int> other;
+	for (int i = n; i > 0; --i) {
+		other.push(-i);
+	}
+	pq.merge(other);
+	long long sum = 0;
+	int last = n, bad = 0;
+	for (int i = 0; i < 1000; ++i) {
+		if (pq.top() > last) ++bad;
+		last = pq.top();
+		sum += last;
+		pq.pop();
+	}
+	std::cout << pq.size() << " " << other.size() << " " << sum << " " << bad << std::endl;
+}
+
+void TestRandom()
+{
+	std::cout << "Testing random merges..." << std::endl;
+	sjtu::priority_queue<unsigned> heaps[8];
+	size_t total = 0;
+	for (int round = 0; round < 200000; ++round) {
+		size_t a = next() % 8, b = next() % 8;
+		switch (next() % 4) {
+			case 0:
+			case 1:
+				heaps[a].push(unsigned(next() % 1000000));
+				++total;
+				break;
+			case 2:
+				if (!heaps[a].empty()) {
+					heaps[a].pop();
+					--total;
+				}
+				break;
+			default:
+				heaps[a].merge(heaps[b]);
+		}
+	}
+	size_t sizes = 0;
+	bool ok = true;
+	for (int i = 0; i < 8; ++i) {
+		sizes += heaps[i].size();
+		unsigned last = ~0u;
+		while (!heaps[i].empty()) {
+			ok = ok && heaps[i].top() <= last;
+			last = heaps[i].top();
+			heaps[i].pop();
+		}
+	}
+	std::cout << (sizes == total) << ok << std::endl;
+}
+
+int comparisons = 0;
+
+struct Touchy {
+	bool operator()(const std::string &a, const std::string &b) const {
+		if (--comparisons == 0) throw 0;
+		return a < b;
+	}
+};
+
+// a comparison that throws halfway through a merge leaves both heaps as they were.
+void TestThrow()
+{
+	std::cout << "Testing throwing comparisons..." << std::endl;
+	sjtu::priority_queue<std::string, Touchy> a, b;
+	comparisons = -1;
+	for (int i = 0; i < 100; ++i) {
+		a.push(std::to_string(next() % 1000));
+		b.push(std::to_string(next() % 1000));
+	}
+	comparisons = 3;
+	try {
+		a.merge(b);
+	} catch (int) {
+		std::cout << "merge failed" << std::endl;
+	}
+	comparisons = -1;
+	sjtu::priority_queue<std::string, Touchy> c(a);
+	size_t n = 0;
+	std::string last = "~";
+	bool ok = true;
+	while (!c.empty()) {
+		ok = ok && !(last < c.top());
+		last = c.top();
+		c.pop();
+		++n;
+	}
+	std::cout << n << ok << " " << b.size() << std::endl;
+}
+
+int main()
+{
+	TestSkewed();
+	TestRandom();
+	TestThrow();
+	return 0;
+}
@@ -0,0 +1,117 @@
+#include <iostream>
+#include <queue>
+#include <sstream>
+#include <string>
+
+#include "priority_queue.hpp"
+
+int rand() {
+	static unsigned reed = 1727417277;
+	return int((reed += (reed << 5) + 172741827) >> 1);
+}
+
+int compareBudget = -1;
+
+struct CountedLess {
+	bool operator()(int a, int b) const {
+		if (compareBudget >= 0 && compareBudget-- == 0) throw std::string("comparison failed");
+		return a < b;
+	}
+};
+
+void TestRoundTrip()
+{
+	std::cout << "Testing save and load..." << std::endl;
+	sjtu::priority_queue<int> pq;
+	std::priority_queue<int> ref;
+	for (int i = 0; i < 400000; ++i) {
+		int x = rand();
+		pq.push(x);
+		ref.push(x);
+	}
+	std::stringstream ss;
+	pq.save(ss);
+	sjtu::priority_queue<int> loaded;
+	loaded.push(7);
+	loaded.load(ss);
+	bool ok = loaded.size() == ref.size() && pq.size() == ref.size();
+	while (!ref.empty()) {
+		ok = ok && loaded.top() == ref.top();
+		loaded.pop();
+		ref.pop();
+	}
+	std::cout << ok << " " << loaded.empty() << std::endl;
+	sjtu::priority_queue<std::string> s;
+	for (int i = 0; i < 1000; ++i) {
+		s.push(std::to_string(rand() % 100000));
+	}
+	std::stringstream st;
+	s.save(st);
+	sjtu::priority_queue<std::string> t;
+	t.load(st);
+	ok = t.size() == s.size();
+	while (!s.empty()) {
+		ok = ok && t.top() == s.top();
+		t.pop();
+		s.pop();
+	}
+	std::cout << ok << std::endl;
+	sjtu::priority_queue<double> e;
+	std::stringstream se;
+	e.save(se);
+	sjtu::priority_queue<double> f;
+	f.push(1.5);
+	f.load(se);
+	std::cout << f.empty() << std::endl;
+}
+
+void TestErrors()
+{
+	std::cout << "Testing bad snapshots..." << std::endl;
+	sjtu::priority_queue<int, CountedLess> pq;
+	for (int i = 0; i < 1000; ++i) {
+		pq.push(rand() % 1000);
+	}
+	std::stringstream ss;
+	pq.save(ss);
+	std::string bytes = ss.str();
+	sjtu::priority_queue<int, CountedLess> target;
+	target.push(42);
+	bool unchanged = true;
+	for (int budget = 0; budget < 2000; budget += 97) {
+		std::stringstream s(bytes);
+		compareBudget = budget;
+		try {
+			target.load(s);
+		} catch (const std::string &e) {
+			unchanged = unchanged && target.size() == 1 && target.top() == 42;
+			continue;
+		}
+		compareBudget = -1;
+		std::cout << "loaded with budget " << budget << " " << unchanged << std::endl;
+		break;
+	}
+	compareBudget = -1;
+	std::cout << target.size() << " " << target.top() << std::endl;
+	std::stringstream s2(bytes.substr(0, 100));
+	try {
+		target.load(s2);
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	sjtu::priority_queue<long long> wrong;
+	std::stringstream s3(bytes);
+	try {
+		wrong.load(s3);
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	std::cout << target.size() << " " << wrong.size() << std::endl;
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestErrors();
+	return 0;
+}
@@ -0,0 +1,210 @@
+#include "priority_queue.hpp"
+
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+unsigned long long seed = 19260817;
+
+unsigned long long next()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed >> 16;
+}
+
+// shortest paths with one entry per vertex, against the lazy version that pushes duplicates.
+template<class Heap>
+bool Dijkstra()
+{
+	typedef std::pair<long long, int> entry;
+	const int n = 20000, m = 200000;
+	std::vector<std::vector<std::pair<int, int>>> adj(n);
+	for (int i = 0; i < m; ++i) {
+		adj[next() % n].push_back({int(next() % n), int(next() % 1000)});
+	}
+	std::vector<long long> lazy(n, -1);
+	std::priority_queue<entry, std::vector<entry>, std::greater<entry>> ref;
+	ref.push({0, 0});
+	while (!ref.empty()) {
+		entry e = ref.top();
+		ref.pop();
+		if (lazy[e.second] >= 0) continue;
+		lazy[e.second] = e.first;
+		for (auto &x : adj[e.second]) {
+			if (lazy[x.first] < 0) ref.push({e.first + x.second, x.first});
+		}
+	}
+	typedef sjtu::priority_queue<entry, std::greater<entry>, Heap> queue;
+	queue pq;
+	std::vector<typename queue::handle> where(n);
+	std::vector<long long> dist(n, -1);
+	std::vector<bool> done(n, false);
+	dist[0] = 0;
+	where[0] = pq.push({0, 0});
+	size_t peak = 0;
+	while (!pq.empty()) {
+		peak = std::max(peak, pq.size());
+		entry e = pq.top();
+		pq.pop();
+		done[e.second] = true;
+		for (auto &x : adj[e.second]) {
+			long long d = e.first + x.second;
+			if (done[x.first]) continue;
+			if (dist[x.first] < 0) {
+				dist[x.first] = d;
+				where[x.first] = pq.push({d, x.first});
+			} else if (d < dist[x.first]) {
+				dist[x.first] = d;
+				pq.increase_key(where[x.first], {d, x.first});
+			}
+		}
+	}
+	return dist == lazy && peak <= size_t(n);
+}
+
+// random updates and erases through handles, checked against a multiset.
+template<class Heap>
+bool Random()
+{
+	typedef sjtu::priority_queue<int, std::less<int>, Heap> queue;
+	queue a, b;
+	std::multiset<int> ref;
+	std::vector<std::pair<typename queue::handle, int>> live;
+	bool ok = true;
+	for (int round = 0; round < 200000; ++round) {
+		switch (next() % 7) {
+			case 0:
+			case 1: {
+				int x = int(next() % 1000000);
+				queue &q = next() % 2 ? a : b;
+				live.push_back({q.push(x), x});
+				ref.insert(x);
+				break;
+			}
+			case 2:
+			case 3: {
+				if (live.empty() || !b.empty()) break;
+				size_t i = next() % live.size();
+				int x = int(next() % 1000000);
+				ref.erase(ref.find(live[i].second));
+				ref.insert(x);
+				ok = ok && a.get(live[i].first) == live[i].second;
+				a.update(live[i].first, x);
+				live[i].second = x;
+				break;
+			}
+			case 4: {
+				if (live.empty() || !b.empty()) break;
+				size_t i = next() % live.size();
+				ref.erase(ref.find(live[i].second));
+				a.erase(live[i].first);
+				live[i] = live.back();
+				live.pop_back();
+				break;
+			}
+			case 5:
+				if (!a.empty() && b.empty()) {
+					ok = ok && a.top() == *ref.rbegin();
+				}
+				break;
+			default:
+				// handles pushed to b now refer to elements of a.
+				a.merge(b);
+		}
+	}
+	a.merge(b);
+	ok = ok && a.size() == ref.size() && b.empty();
+	queue c(a);
+	while (!a.empty()) {
+		ok = ok && a.top() == *ref.rbegin() && c.top() == a.top();
+		ref.erase(std::prev(ref.end()));
+		a.pop();
+		c.pop();
+	}
+	return ok && c.empty();
+}
+
+int comparisons = -1;
+
+struct Touchy {
+	bool operator()(const std::string &a, const std::string &b) const {
+		if (comparisons >= 0 && comparisons-- == 0) throw 0;
+		return a < b;
+	}
+};
+
+// a comparison that throws halfway leaves the queue as it was.
+template<class Heap>
+bool Throwing()
+{
+	typedef sjtu::priority_queue<std::string, Touchy, Heap> queue;
+	queue pq;
+	std::vector<typename queue::handle> handles;
+	comparisons = -1;
+	for (int i = 0; i < 500; ++i) {
+		pq.push(std::to_string(100000 + next() % 100000));
+	}
+	for (int i = 0; i < 100; ++i) {
+		pq.pop();
+	}
+	for (int i = 0; i < 600; ++i) {
+		handles.push_back(pq.push(std::to_string(100000 + next() % 100000)));
+	}
+	queue saved(pq);
+	int failures = 0;
+	for (int i = 0; i < 600; ++i) {
+		comparisons = int(next() % 4);
+		try {
+			switch (i % 3) {
+				case 0:
+					pq.increase_key(handles[i], "9" + pq.get(handles[i]));
+					break;
+				case 1:
+					pq.decrease_key(handles[i], "0" + pq.get(handles[i]));
+					break;
+				default:
+					pq.erase(handles[i]);
+			}
+		} catch (int) {
+			++failures;
+			comparisons = -1;
+			queue a(pq), b(saved);
+			bool same = a.size() == b.size();
+			while (same && !a.empty()) {
+				same = a.top() == b.top();
+				a.pop();
+				b.pop();
+			}
+			if (!same) return false;
+			continue;
+		}
+		comparisons = -1;
+		saved = pq;
+	}
+	return failures > 0;
+}
+
+template<class Heap>
+void Test(const char *name)
+{
+	std::cout << name << " " << Dijkstra<Heap>() << Random<Heap>() << Throwing<Heap>() << std::endl;
+}
+
+int main()
+{
+	Test<sjtu::leftist_heap>("leftist");
+	Test<sjtu::pairing_heap>("pairing");
+	sjtu::priority_queue<int> pq;
+	try {
+		pq.erase(sjtu::priority_queue<int>::handle());
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "invalid handle" << std::endl;
+	}
+	return 0;
+}
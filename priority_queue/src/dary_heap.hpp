@@ -0,0 +1,279 @@
+#ifndef SJTU_DARY_HEAP_HPP
+#define SJTU_DARY_HEAP_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+
+namespace sjtu {
+/**
+ * the implicit d-ary heap backend of priority_queue.
+ *
+ * the elements sit in one array in level order, the children of slot i being
+ * slots D i + 1 ... D i + D. There are no nodes or pointers, and push and pop
+ * only touch the O(log_D n) slots on one root-to-leaf path, which makes this
+ * the most cache-friendly backend; with D = 4 the children of a small element
+ * share a cache line.
+ *
+ * the price is merge: the elements of the smaller heap are pushed into the
+ * larger one, O(m log n) for m of them, instead of O(log n), and with only
+ * the basic guarantee if Compare throws. Elements have no handles either.
+ */
+    template<size_t D = 4>
+    struct dary_heap {
+        static_assert(D >= 2, "a d-ary heap needs at least two children per slot");
+
+        template<typename T, class Compare>
+        class heap;
+    };
+
+    template<size_t D>
+    template<typename T, class Compare>
+    class dary_heap<D>::heap {
+    private:
+        // items[0, curLen) hold the elements, items[curLen, maxSiz) are raw memory.
+        T *items;
+        size_t curLen, maxSiz;
+
+        static const size_t minCapacity = 16;
+        // no root-to-leaf path of a heap that fits in memory is longer.
+        static const size_t maxDepth = 64;
+        // assign allocates at most this many slots before it has seen the elements.
+        static const size_t assignRun = 4096;
+
+        static T *allocate(size_t n) {
+            if (n > size_t(-1) / sizeof(T)) throw std::bad_array_new_length();
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        static void deallocate(T *p) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        }
+
+        static void destroyRange(T *p, size_t n) {
+            if constexpr (!std::is_trivially_destructible<T>::value) {
+                for (size_t i = 0; i < n; ++i) p[i].~T();
+            }
+        }
+
+        static size_t parent(size_t i) {
+            return (i - 1) / D;
+        }
+
+        /**
+         * the slot at or above i where e belongs on its way up, found with
+         * comparisons only.
+         */
+        static size_t climb(const T *a, const T &e, size_t i) {
+            while (i > 0 && Compare()(a[parent(i)], e)) i = parent(i);
+            return i;
+        }
+
+        /**
+         * the slots below i that e has to pass on its way down a heap of n
+         * elements, stored in path; found with comparisons only.
+         */
+        static size_t descend(const T *a, const T &e, size_t i, size_t n, size_t *path) {
+            size_t k = 0;
+            for (size_t c; (c = i * D + 1) < n;) {
+                size_t end = n - c > D ? c + D : n;
+                size_t best = c;
+                for (size_t j = c + 1; j < end; ++j) {
+                    if (Compare()(a[best], a[j])) best = j;
+                }
+                if (!Compare()(e, a[best])) break;
+                path[k++] = best;
+                i = best;
+            }
+            return k;
+        }
+
+        // Floyd's bottom-up heap construction, O(n).
+        static void heapify(T *a, size_t n) {
+            size_t path[maxDepth];
+            for (size_t i = n > 1 ? parent(n - 1) + 1 : 0; i-- > 0;) {
+                size_t k = descend(a, a[i], i, n, path);
+                if (k == 0) continue;
+                T tmp(std::move(a[i]));
+                size_t hole = i;
+                for (size_t j = 0; j < k; ++j) {
+                    a[hole] = std::move(a[path[j]]);
+                    hole = path[j];
+                }
+                a[hole] = std::move(tmp);
+            }
+        }
+
+        /**
+         * puts e in slot i, found by climb from the first free slot: the
+         * elements on the path between them move one level down.
+         */
+        void rise(size_t i, T &&e) {
+            size_t j = curLen;
+            if (j == i) {
+                new(items + j) T(std::move(e));
+                ++curLen;
+                return;
+            }
+            new(items + j) T(std::move(items[parent(j)]));
+            ++curLen;
+            for (j = parent(j); j != i; j = parent(j)) items[j] = std::move(items[parent(j)]);
+            items[i] = std::move(e);
+        }
+
+        // makes room for n elements.
+        void reserve(size_t n) {
+            if (n <= maxSiz) return;
+            size_t cap = maxSiz <= size_t(-1) / sizeof(T) / 2 && maxSiz * 2 > n ? maxSiz * 2 : n;
+            if (cap < minCapacity) cap = minCapacity;
+            T *p = allocate(cap);
+            size_t i = 0;
+            try {
+                for (; i < curLen; ++i) new(p + i) T(std::move_if_noexcept(items[i]));
+            } catch (...) {
+                destroyRange(p, i);
+                deallocate(p);
+                throw;
+            }
+            destroyRange(items, curLen);
+            deallocate(items);
+            items = p;
+            maxSiz = cap;
+        }
+
+        void swapWith(heap &other) {
+            std::swap(items, other.items);
+            std::swap(curLen, other.curLen);
+            std::swap(maxSiz, other.maxSiz);
+        }
+
+    public:
+        // elements move between slots on every push and pop, so there are no
+        // handles to them: push returns nothing, and update and erase are missing.
+        class handle;
+
+        heap() : items(nullptr), curLen(0), maxSiz(0) {}
+
+        heap(const heap &other) : items(nullptr), curLen(0), maxSiz(0) {
+            if (other.curLen == 0) return;
+            items = allocate(other.curLen);
+            maxSiz = other.curLen;
+            try {
+                for (; curLen < other.curLen; ++curLen) new(items + curLen) T(other.items[curLen]);
+            } catch (...) {
+                destroyRange(items, curLen);
+                deallocate(items);
+                throw;
+            }
+        }
+
+        ~heap() {
+            destroyRange(items, curLen);
+            deallocate(items);
+        }
+
+        heap &operator=(const heap &other) {
+            if (this == &other) return *this;
+            heap copy(other);
+            swapWith(copy);
+            return *this;
+        }
+
+        const T &top() const {
+            return items[0];
+        }
+
+        /**
+         * throw runtime_error if Compare throws; the heap is left unchanged.
+         */
+        void push(const T &e) {
+            // e may be one of the elements, so copy it before the buffer can move.
+            T tmp(e);
+            reserve(curLen + 1);
+            size_t i;
+            try {
+                i = climb(items, tmp, curLen);
+            } catch (...) {
+                throw runtime_error();
+            }
+            rise(i, std::move(tmp));
+        }
+
+        /**
+         * the path of the last element is found before anything moves, so if
+         * Compare throws, the heap is left unchanged.
+         */
+        void pop() {
+            size_t last = curLen - 1;
+            size_t path[maxDepth];
+            size_t k = descend(items, items[last], 0, last, path);
+            size_t hole = 0;
+            for (size_t j = 0; j < k; ++j) {
+                items[hole] = std::move(items[path[j]]);
+                hole = path[j];
+            }
+            if (hole != last) items[hole] = std::move(items[last]);
+            items[last].~T();
+            curLen = last;
+        }
+
+        size_t size() const {
+            return curLen;
+        }
+
+        bool empty() const {
+            return curLen == 0;
+        }
+
+        /**
+         * moves every element of the smaller heap into the larger one, taken
+         * from its back so that what is left of it stays a heap; other ends up
+         * empty. If Compare throws, both heaps are still valid and no element
+         * is lost, but some may already have moved from one to the other.
+         */
+        void merge(heap &other) {
+            if (this == &other || other.curLen == 0) return;
+            heap &big = other.curLen > curLen ? other : *this;
+            big.reserve(curLen + other.curLen);
+            if (&big == &other) swapWith(other);
+            while (other.curLen > 0) {
+                size_t last = other.curLen - 1;
+                size_t i = climb(items, other.items[last], curLen);
+                rise(i, std::move(other.items[last]));
+                other.items[last].~T();
+                other.curLen = last;
+            }
+        }
+
+        /**
+         * calls f on every element, in no particular order.
+         */
+        template<class F>
+        void for_each(F f) const {
+            for (size_t i = 0; i < curLen; ++i) f(static_cast<const T &>(items[i]));
+        }
+
+        /**
+         * replaces the elements with n elements returned by gen(), arranged
+         * into a heap bottom-up with O(n) comparisons.
+         * n may come from an untrusted snapshot, so the array grows as the
+         * elements arrive and a gen that fails early has allocated little.
+         * if gen or Compare throws, the heap is left unchanged.
+         */
+        template<class Gen>
+        void assign(size_t n, Gen gen) {
+            heap tmp;
+            tmp.reserve(n < assignRun ? n : assignRun);
+            for (; tmp.curLen < n; ++tmp.curLen) {
+                if (tmp.curLen == tmp.maxSiz) tmp.reserve(tmp.curLen + 1);
+                new(tmp.items + tmp.curLen) T(gen());
+            }
+            heapify(tmp.items, n);
+            swapWith(tmp);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,446 @@
+#ifndef SJTU_LEFTIST_HEAP_HPP
+#define SJTU_LEFTIST_HEAP_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "node_pool.hpp"
+
+namespace sjtu {
+/**
+ * the leftist heap backend of priority_queue, and its default.
+ *
+ * push, pop and merge all walk right spines, which are at most O(log n) long,
+ * so merging two queues is O(log n). Elements live inside the nodes, and the
+ * nodes come from a per-heap node_pool: once the heap has been as large as it
+ * gets, push and pop recycle nodes without touching operator new.
+ *
+ * every node also knows its parent, which makes the heap addressable: a
+ * handle names one element and lets it be changed or erased in O(log n) by
+ * cutting its subtree out, fixing the null path lengths above it and merging
+ * the subtree back in.
+ */
+    struct leftist_heap {
+        template<typename T, class Compare>
+        class heap;
+    };
+
+    template<typename T, class Compare>
+    class leftist_heap::heap {
+    private:
+        struct node {
+            T data;
+            node *left, *right, *parent;
+            int npl;
+
+            template<typename... Args>
+            explicit node(Args &&...args) : data(std::forward<Args>(args)...), left(nullptr), right(nullptr),
+                                            parent(nullptr), npl(0) {}
+
+            bool operator<(const node &other) {
+                return !Compare()(data, other.data);
+            }
+        };
+
+        node *root;
+        size_t size1;
+        node_pool<node> pool;
+
+        // a node holding T(args...), built in a slot of the pool.
+        template<typename... Args>
+        node *create(Args &&...args) {
+            void *p = pool.allocate();
+            try {
+                return new(p) node(std::forward<Args>(args)...);
+            } catch (...) {
+                pool.deallocate(p);
+                throw;
+            }
+        }
+
+        void destroy(node *t) {
+            t->~node();
+            pool.deallocate(t);
+        }
+
+        // the right spine of a leftist heap of n nodes has at most log2(n + 1) nodes,
+        // so merging two heaps walks at most 2 * 64 nodes on any 64-bit machine.
+        static const size_t maxSpine = 2 * 64;
+
+        /**
+         * merges the heaps l and r along their right spines, without recursion.
+         * the first pass only compares, recording the winners on a bounded stack;
+         * the second links them bottom-up and restores the null path lengths.
+         * the root of the result has no parent.
+         * if Compare throws, both heaps are left untouched.
+         */
+        node *merge(node *l, node *r) {
+            node *path[maxSpine];
+            size_t k = 0;
+            node *a = l, *b = r;
+            bool leftFree = false;
+            while (a != nullptr && b != nullptr) {
+                if (!(*a < *b)) {
+                    node *tmp = a;
+                    a = b;
+                    b = tmp;
+                }
+                path[k++] = a;
+                if (a->left == nullptr) {
+                    leftFree = true;
+                    break;
+                }
+                a = a->right;
+            }
+            node *sub;
+            if (leftFree) {
+                // a node with no left child has no right child either: b becomes its only child.
+                sub = path[--k];
+                sub->left = b;
+                b->parent = sub;
+            } else {
+                sub = a != nullptr ? a : b;
+            }
+            while (k > 0) {
+                node *t = path[--k];
+                t->right = sub;
+                sub->parent = t;
+                if (t->left->npl < t->right->npl) swapChildren(t);
+                t->npl = t->right->npl + 1;
+                sub = t;
+            }
+            if (sub != nullptr) sub->parent = nullptr;
+            return sub;
+        }
+
+        void swapChildren(node *t) {
+            node *tmp;
+            tmp = t->left;
+            t->left = t->right;
+            t->right = tmp;
+        }
+
+        // the link that points at t: root or a child pointer of its parent.
+        node *&slot(node *t) {
+            if (t->parent == nullptr) return root;
+            return t->parent->left == t ? t->parent->left : t->parent->right;
+        }
+
+        /**
+         * walks up from p, which has just lost or changed a child, swapping
+         * children where the leftist property broke and updating null path
+         * lengths until one of them stays the same.
+         */
+        void fixUp(node *p) {
+            while (p != nullptr) {
+                if (p->left == nullptr) {
+                    p->left = p->right;
+                    p->right = nullptr;
+                } else if (p->right != nullptr && p->left->npl < p->right->npl) {
+                    swapChildren(p);
+                }
+                int npl = p->right != nullptr ? p->right->npl + 1 : 0;
+                if (npl == p->npl) break;
+                p->npl = npl;
+                p = p->parent;
+            }
+        }
+
+        /**
+         * puts the heap c where t was; c must be detached and hold nothing
+         * above t's parent. Afterwards the parent has no right child if c is null.
+         */
+        void replace(node *t, node *c) {
+            node *p = t->parent;
+            slot(t) = c;
+            if (c != nullptr) c->parent = p;
+            t->parent = nullptr;
+            fixUp(p);
+        }
+
+        /**
+         * merges t, just cut out of the heap and holding a new value, back in.
+         * if Compare throws, t gets back old and is put back below its old
+         * parent p, or above c, the heap that took its place. The values are
+         * swapped, so this relies on T's move not throwing.
+         */
+        void mergeBack(node *t, T &old, node *p, node *c) {
+            std::swap(t->data, old);
+            try {
+                root = merge(root, t);
+            } catch (...) {
+                std::swap(t->data, old);
+                if (c != nullptr) {
+                    replace(c, t);
+                    t->left = c;
+                    c->parent = t;
+                } else if (p != nullptr) {
+                    p->right = t;
+                    t->parent = p;
+                    fixUp(p);
+                } else {
+                    root = t;
+                }
+                throw;
+            }
+        }
+
+        /**
+         * returns a copy of the heap other, which has n nodes.
+         * the left spine can be O(n) long, so the walk keeps its own stack of
+         * nodes still to be copied instead of recursing.
+         * if copying an element throws, the partial copy is freed.
+         */
+        node *build(const node *other, size_t n) {
+            if (other == nullptr) return nullptr;
+            struct pending {
+                const node *from;
+                node **to;
+                node *parent;
+            };
+            pending *stack = new pending[n];
+            size_t top = 0;
+            node *copy = nullptr;
+            stack[top++] = {other, &copy, nullptr};
+            try {
+                while (top > 0) {
+                    pending p = stack[--top];
+                    node *t = create(p.from->data);
+                    *p.to = t;
+                    t->parent = p.parent;
+                    t->npl = p.from->npl;
+                    if (p.from->right) stack[top++] = {p.from->right, &t->right, t};
+                    if (p.from->left) stack[top++] = {p.from->left, &t->left, t};
+                }
+            } catch (...) {
+                delete[] stack;
+                clear(copy);
+                throw;
+            }
+            delete[] stack;
+            return copy;
+        }
+
+        /**
+         * frees the heap t in O(n) time and O(1) space: a node with a left child
+         * is rotated right until the leftmost node is on top, which is then freed.
+         */
+        void clear(node *t) {
+            while (t != nullptr) {
+                if (t->left != nullptr) {
+                    node *l = t->left;
+                    t->left = l->right;
+                    l->right = t;
+                    t = l;
+                } else {
+                    node *next = t->right;
+                    destroy(t);
+                    t = next;
+                }
+            }
+        }
+
+    public:
+        /**
+         * names one element from its push until it is popped or erased,
+         * also after a merge moves it into another heap.
+         */
+        class handle {
+            friend class heap;
+
+            node *p;
+
+            explicit handle(node *p) : p(p) {}
+
+        public:
+            handle() : p(nullptr) {}
+
+            bool operator==(const handle &other) const {
+                return p == other.p;
+            }
+
+            bool operator!=(const handle &other) const {
+                return p != other.p;
+            }
+        };
+
+        heap() : root(nullptr), size1(0) {}
+
+        heap(const heap &other) : root(nullptr), size1(0) {
+            // after the member initializers: build takes its nodes from pool.
+            root = build(other.root, other.size1);
+            size1 = other.size1;
+        }
+
+        ~heap() {
+            // the pool frees the memory; elements that need no destructor are not even visited.
+            if constexpr (!std::is_trivially_destructible<T>::value) clear(root);
+        }
+
+        heap &operator=(const heap &other) {
+            if (this == &other) return *this;
+            node *copy = build(other.root, other.size1);
+            clear(root);
+            root = copy;
+            size1 = other.size1;
+            return *this;
+        }
+
+        const T &top() const {
+            return root->data;
+        }
+
+        /**
+         * throw runtime_error if Compare throws; the heap is left unchanged.
+         */
+        handle push(const T &e) {
+            auto p1 = create(e);
+            try {
+                root = merge(p1, root);
+            }
+            catch (...){
+                destroy(p1);
+                throw runtime_error();
+            }
+            size1++;
+            return handle(p1);
+        }
+
+        void pop() {
+            auto tmp = root;
+            root = merge(root->left, root->right);
+            destroy(tmp);
+            size1--;
+        }
+
+        size_t size() const {
+            return size1;
+        }
+
+        bool empty() const {
+            return root == nullptr;
+        }
+
+        /**
+         * O(log n); other is left empty and its pool is handed over with its nodes.
+         * if Compare throws, both heaps are left untouched.
+         */
+        void merge(heap &other) {
+            if (this == &other) return;
+            root = merge(root, other.root);
+            pool.splice(other.pool);
+            other.root = nullptr;
+            size1 += other.size1;
+            other.size1 = 0;
+        }
+
+        const T &get(handle h) const {
+            return h.p->data;
+        }
+
+        /**
+         * gives h's element the value e, which Compare must not rank below the
+         * old one: its subtree is cut out and merged in again from the root.
+         * if Compare throws, the heap is left unchanged.
+         */
+        void increase_key(handle h, const T &e) {
+            node *t = h.p;
+            T tmp(e);
+            if (t == root) {
+                t->data = std::move(tmp);
+                return;
+            }
+            node *p = t->parent;
+            replace(t, nullptr);
+            mergeBack(t, tmp, p, nullptr);
+        }
+
+        /**
+         * gives h's element the value e, which Compare must not rank above the
+         * old one: its children take its place and it is merged in again alone.
+         * if Compare throws, the heap is left unchanged.
+         */
+        void decrease_key(handle h, const T &e) {
+            node *t = h.p;
+            T tmp(e);
+            node *c = merge(t->left, t->right);
+            node *p = t->parent;
+            replace(t, c);
+            t->left = t->right = nullptr;
+            t->npl = 0;
+            mergeBack(t, tmp, p, c);
+        }
+
+        /**
+         * removes h's element; its children take its place.
+         * if Compare throws, the heap is left unchanged.
+         */
+        void erase(handle h) {
+            node *t = h.p;
+            replace(t, merge(t->left, t->right));
+            destroy(t);
+            size1--;
+        }
+
+        /**
+         * calls f on every element, in no particular order.
+         */
+        template<class F>
+        void for_each(F f) const {
+            if (root == nullptr) return;
+            // the left spine of a leftist heap can be O(n) long, so walk it with an explicit stack.
+            node **stack = new node *[size1];
+            size_t top = 0;
+            stack[top++] = root;
+            try {
+                while (top > 0) {
+                    node *t = stack[--top];
+                    f(static_cast<const T &>(t->data));
+                    if (t->right) stack[top++] = t->right;
+                    if (t->left) stack[top++] = t->left;
+                }
+            } catch (...) {
+                delete[] stack;
+                throw;
+            }
+            delete[] stack;
+        }
+
+        /**
+         * replaces the elements with n elements returned by gen(), built
+         * bottom-up with O(n) comparisons: like a binary counter, each new node
+         * is merged with the heaps of 1, 2, 4, ... nodes before it while they
+         * have the same size as its own, so the nodes being merged were made
+         * recently and are still in cache.
+         * if gen or Compare throws, the heap is left unchanged.
+         */
+        template<class Gen>
+        void assign(size_t n, Gen gen) {
+            // the sizes of the heaps on the stack are distinct powers of two.
+            node *stack[66];
+            size_t k = 0;
+            try {
+                for (size_t i = 1; i <= n; ++i) {
+                    stack[k++] = create(gen());
+                    for (size_t c = i; c % 2 == 0; c /= 2) {
+                        stack[k - 2] = merge(stack[k - 2], stack[k - 1]);
+                        --k;
+                    }
+                }
+                for (; k > 1; --k) stack[k - 2] = merge(stack[k - 2], stack[k - 1]);
+            } catch (...) {
+                // a failed merge leaves both heaps intact on the stack.
+                for (size_t j = 0; j < k; ++j) clear(stack[j]);
+                throw;
+            }
+            node *t = k > 0 ? stack[0] : nullptr;
+            clear(root);
+            root = t;
+            size1 = n;
+        }
+    };
+}
+
+#endif
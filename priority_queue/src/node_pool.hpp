@@ -0,0 +1,126 @@
+#ifndef SJTU_NODE_POOL_HPP
+#define SJTU_NODE_POOL_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace sjtu {
+/**
+ * raw memory for objects of type Node, carved from slabs that hold 32, 64,
+ * ... up to 4096 of them. A freed slot goes onto a free list and is handed
+ * out again before any new slab is touched, so a container that keeps
+ * allocating and freeing nodes stops calling operator new once it has
+ * reached its peak size.
+ *
+ * slabs are only returned by the destructor, after every node has been
+ * destroyed (or, for trivially destructible nodes, simply forgotten).
+ * splice hands all of one pool's memory to another in O(1), which lets the
+ * nodes of two containers be merged without copying them.
+ */
+    template<typename Node>
+    class node_pool {
+    public:
+        node_pool() : slabs(nullptr), lastSlab(nullptr), freeList(nullptr), lastFree(nullptr),
+                      cur(nullptr), end(nullptr), nextSlab(minSlab) {}
+
+        node_pool(const node_pool &) = delete;
+
+        node_pool &operator=(const node_pool &) = delete;
+
+        ~node_pool() {
+            while (slabs != nullptr) {
+                slab *next = slabs->next;
+                ::operator delete(slabs);
+                slabs = next;
+            }
+        }
+
+        /**
+         * a raw slot for one Node; throws std::bad_alloc if a new slab cannot be allocated.
+         */
+        void *allocate() {
+            if (freeList != nullptr) {
+                slot *p = freeList;
+                freeList = p->next;
+                if (freeList == nullptr) lastFree = nullptr;
+                return p;
+            }
+            if (cur == end) refill();
+            void *p = cur;
+            cur += slotSize;
+            return p;
+        }
+
+        /**
+         * takes back a slot from allocate whose Node has been destroyed.
+         */
+        void deallocate(void *p) {
+            slot *s = static_cast<slot *>(p);
+            s->next = freeList;
+            if (freeList == nullptr) lastFree = s;
+            freeList = s;
+        }
+
+        /**
+         * takes over every slab and free slot of other, which is left empty.
+         * nodes allocated from other may then be freed to this pool.
+         */
+        void splice(node_pool &other) {
+            if (this == &other || other.slabs == nullptr) return;
+            other.lastSlab->next = slabs;
+            if (slabs == nullptr) lastSlab = other.lastSlab;
+            slabs = other.slabs;
+            if (other.freeList != nullptr) {
+                other.lastFree->next = freeList;
+                if (freeList == nullptr) lastFree = other.lastFree;
+                freeList = other.freeList;
+            }
+            // only one run of fresh slots can be kept; the shorter one stays unused.
+            if (other.end - other.cur > end - cur) {
+                cur = other.cur;
+                end = other.end;
+            }
+            if (other.nextSlab > nextSlab) nextSlab = other.nextSlab;
+            other.slabs = other.lastSlab = nullptr;
+            other.freeList = other.lastFree = nullptr;
+            other.cur = other.end = nullptr;
+            other.nextSlab = minSlab;
+        }
+
+    private:
+        struct slot {
+            slot *next;
+        };
+
+        struct slab {
+            slab *next;
+        };
+
+        static constexpr size_t align = alignof(Node) > alignof(slot) ? alignof(Node) : alignof(slot);
+        static constexpr size_t rawSize = sizeof(Node) > sizeof(slot) ? sizeof(Node) : sizeof(slot);
+        static constexpr size_t slotSize = (rawSize + align - 1) / align * align;
+        static constexpr size_t headerSize = (sizeof(slab) + align - 1) / align * align;
+        static constexpr size_t minSlab = 32;
+        static constexpr size_t maxSlab = 4096;
+
+        static_assert(align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "node_pool does not support over-aligned nodes");
+
+        slab *slabs, *lastSlab;
+        slot *freeList, *lastFree;
+        // the slots of the newest slab that were never handed out.
+        char *cur, *end;
+        size_t nextSlab;
+
+        void refill() {
+            slab *s = static_cast<slab *>(::operator new(headerSize + nextSlab * slotSize));
+            s->next = slabs;
+            if (slabs == nullptr) lastSlab = s;
+            slabs = s;
+            cur = reinterpret_cast<char *>(s) + headerSize;
+            end = cur + nextSlab * slotSize;
+            if (nextSlab < maxSlab) nextSlab *= 2;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,459 @@
+#ifndef SJTU_PAIRING_HEAP_HPP
+#define SJTU_PAIRING_HEAP_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "node_pool.hpp"
+
+namespace sjtu {
+/**
+ * the pairing heap backend of priority_queue.
+ *
+ * push and merge link two roots with one comparison, O(1). pop removes the
+ * root and combines its children with the two-pass rule: neighbours are linked
+ * in pairs from left to right, then the pairs are linked from right to left.
+ * That is O(log n) amortized, and usually the fastest of the backends when
+ * merges are frequent.
+ *
+ * each node keeps its first child and its next sibling, so the heap is a
+ * binary tree and is copied and freed with the same loops as the leftist heap.
+ * nodes come from a per-heap node_pool.
+ *
+ * each node also keeps prev, its parent if it is a first child and its
+ * previous sibling otherwise, so a handle's node can be cut out in O(1): an
+ * element that moves up is cut and linked to the root, and one that moves
+ * down or is erased has its children combined in its place.
+ */
+    struct pairing_heap {
+        template<typename T, class Compare>
+        class heap;
+    };
+
+    template<typename T, class Compare>
+    class pairing_heap::heap {
+    private:
+        struct node {
+            T data;
+            node *child, *next, *prev;
+
+            template<typename... Args>
+            explicit node(Args &&...args) : data(std::forward<Args>(args)...), child(nullptr), next(nullptr),
+                                            prev(nullptr) {}
+        };
+
+        // one pair of the first pass: the winner, the loser (null for an odd last
+        // child) and whether the winner also beats every pair to its right.
+        struct pairing {
+            node *win, *lose;
+            bool up;
+        };
+
+        node *root;
+        size_t size1;
+        node_pool<node> pool;
+        // scratch space for combining children, kept between calls; the first
+        // pairsLen entries are the plan made by the last call to plan.
+        pairing *pairs;
+        size_t pairsLen, pairsCap;
+
+        template<typename... Args>
+        node *create(Args &&...args) {
+            void *p = pool.allocate();
+            try {
+                return new(p) node(std::forward<Args>(args)...);
+            } catch (...) {
+                pool.deallocate(p);
+                throw;
+            }
+        }
+
+        void destroy(node *t) {
+            t->~node();
+            pool.deallocate(t);
+        }
+
+        // makes the root b the first child of a.
+        static void attach(node *a, node *b) {
+            b->next = a->child;
+            if (a->child != nullptr) a->child->prev = b;
+            b->prev = a;
+            a->child = b;
+        }
+
+        // makes the root that loses to the other its first child.
+        static node *link(node *a, node *b) {
+            if (a == nullptr) return b;
+            if (b == nullptr) return a;
+            if (Compare()(a->data, b->data)) {
+                node *tmp = a;
+                a = b;
+                b = tmp;
+            }
+            attach(a, b);
+            return a;
+        }
+
+        // takes t and its subtree out of the sibling list it is in.
+        static void cut(node *t) {
+            if (t->prev->child == t) {
+                t->prev->child = t->next;
+            } else {
+                t->prev->next = t->next;
+            }
+            if (t->next != nullptr) t->next->prev = t->prev;
+            t->next = t->prev = nullptr;
+        }
+
+        /**
+         * makes every comparison needed to combine the sibling list first by
+         * the two-pass rule, and returns the node that will end up on top;
+         * nothing is relinked until relink carries out the plan.
+         */
+        node *plan(node *first) {
+            pairsLen = 0;
+            if (first == nullptr) return nullptr;
+            size_t m = 0;
+            for (node *a = first; a != nullptr; a = a->next != nullptr ? a->next->next : nullptr) ++m;
+            if (m > pairsCap) {
+                size_t cap = pairsCap * 2 > m ? pairsCap * 2 : m;
+                pairing *p = new pairing[cap];
+                delete[] pairs;
+                pairs = p;
+                pairsCap = cap;
+            }
+            size_t k = 0;
+            for (node *a = first; a != nullptr; ++k) {
+                node *b = a->next;
+                pairs[k] = {a, b, false};
+                a = b != nullptr ? b->next : nullptr;
+            }
+            for (k = 0; k < m; ++k) {
+                pairing &p = pairs[k];
+                if (p.lose != nullptr && Compare()(p.win->data, p.lose->data)) {
+                    node *tmp = p.win;
+                    p.win = p.lose;
+                    p.lose = tmp;
+                }
+            }
+            size_t best = m - 1;
+            for (k = m - 1; k-- > 0;) {
+                pairs[k].up = !Compare()(pairs[k].win->data, pairs[best].win->data);
+                if (pairs[k].up) best = k;
+            }
+            pairsLen = m;
+            return pairs[best].win;
+        }
+
+        // links the nodes as the last plan decided, without comparing; returns the new root.
+        node *relink() {
+            size_t m = pairsLen;
+            if (m == 0) return nullptr;
+            for (size_t k = 0; k < m; ++k) {
+                if (pairs[k].lose != nullptr) attach(pairs[k].win, pairs[k].lose);
+            }
+            node *acc = pairs[m - 1].win;
+            for (size_t k = m - 1; k-- > 0;) {
+                node *w = pairs[k].win;
+                if (pairs[k].up) {
+                    attach(w, acc);
+                    acc = w;
+                } else {
+                    attach(acc, w);
+                }
+            }
+            acc->next = acc->prev = nullptr;
+            pairsLen = 0;
+            return acc;
+        }
+
+        /**
+         * the heap made of the sibling list first, by the two-pass rule.
+         * every comparison is made before any node is relinked, so if Compare
+         * throws, the list is left untouched.
+         */
+        node *combine(node *first) {
+            plan(first);
+            return relink();
+        }
+
+        /**
+         * returns a copy of the heap other, which has n nodes, walking it with
+         * an explicit stack; if copying an element throws, the partial copy is freed.
+         */
+        node *build(const node *other, size_t n) {
+            if (other == nullptr) return nullptr;
+            struct pending {
+                const node *from;
+                node **to;
+                node *prev;
+            };
+            pending *stack = new pending[n];
+            size_t top = 0;
+            node *copy = nullptr;
+            stack[top++] = {other, &copy, nullptr};
+            try {
+                while (top > 0) {
+                    pending p = stack[--top];
+                    node *t = create(p.from->data);
+                    *p.to = t;
+                    t->prev = p.prev;
+                    if (p.from->next) stack[top++] = {p.from->next, &t->next, t};
+                    if (p.from->child) stack[top++] = {p.from->child, &t->child, t};
+                }
+            } catch (...) {
+                delete[] stack;
+                clear(copy);
+                throw;
+            }
+            delete[] stack;
+            return copy;
+        }
+
+        /**
+         * frees the heap t in O(n) time and O(1) space by rotating children up
+         * into the sibling list.
+         */
+        void clear(node *t) {
+            while (t != nullptr) {
+                if (t->child != nullptr) {
+                    node *c = t->child;
+                    t->child = c->next;
+                    c->next = t;
+                    t = c;
+                } else {
+                    node *next = t->next;
+                    destroy(t);
+                    t = next;
+                }
+            }
+        }
+
+    public:
+        /**
+         * names one element from its push until it is popped or erased,
+         * also after a merge moves it into another heap.
+         */
+        class handle {
+            friend class heap;
+
+            node *p;
+
+            explicit handle(node *p) : p(p) {}
+
+        public:
+            handle() : p(nullptr) {}
+
+            bool operator==(const handle &other) const {
+                return p == other.p;
+            }
+
+            bool operator!=(const handle &other) const {
+                return p != other.p;
+            }
+        };
+
+        heap() : root(nullptr), size1(0), pairs(nullptr), pairsLen(0), pairsCap(0) {}
+
+        heap(const heap &other) : root(nullptr), size1(0), pairs(nullptr), pairsLen(0), pairsCap(0) {
+            // after the member initializers: build takes its nodes from pool.
+            root = build(other.root, other.size1);
+            size1 = other.size1;
+        }
+
+        ~heap() {
+            if constexpr (!std::is_trivially_destructible<T>::value) clear(root);
+            delete[] pairs;
+        }
+
+        heap &operator=(const heap &other) {
+            if (this == &other) return *this;
+            node *copy = build(other.root, other.size1);
+            clear(root);
+            root = copy;
+            size1 = other.size1;
+            return *this;
+        }
+
+        const T &top() const {
+            return root->data;
+        }
+
+        /**
+         * throw runtime_error if Compare throws; the heap is left unchanged.
+         */
+        handle push(const T &e) {
+            node *t = create(e);
+            try {
+                root = link(t, root);
+            } catch (...) {
+                destroy(t);
+                throw runtime_error();
+            }
+            size1++;
+            return handle(t);
+        }
+
+        /**
+         * if Compare throws, the heap is left unchanged.
+         */
+        void pop() {
+            node *t = root;
+            root = combine(t->child);
+            destroy(t);
+            size1--;
+        }
+
+        size_t size() const {
+            return size1;
+        }
+
+        bool empty() const {
+            return root == nullptr;
+        }
+
+        /**
+         * O(1); other is left empty and its pool is handed over with its nodes.
+         * if Compare throws, both heaps are left untouched.
+         */
+        void merge(heap &other) {
+            if (this == &other) return;
+            root = link(root, other.root);
+            pool.splice(other.pool);
+            other.root = nullptr;
+            size1 += other.size1;
+            other.size1 = 0;
+        }
+
+        const T &get(handle h) const {
+            return h.p->data;
+        }
+
+        /**
+         * gives h's element the value e, which Compare must not rank below the
+         * old one: it is cut out with its subtree and linked to the root, O(1).
+         * if Compare throws, the heap is left unchanged.
+         */
+        void increase_key(handle h, const T &e) {
+            node *t = h.p;
+            if (t == root) {
+                t->data = e;
+                return;
+            }
+            bool up = Compare()(root->data, e);
+            t->data = e;
+            cut(t);
+            if (up) {
+                attach(t, root);
+                root = t;
+            } else {
+                attach(root, t);
+            }
+        }
+
+        /**
+         * gives h's element the value e, which Compare must not rank above the
+         * old one: its children are combined in its place and it goes back
+         * alone, O(log n) amortized.
+         * if Compare throws, the heap is left unchanged.
+         */
+        void decrease_key(handle h, const T &e) {
+            node *t = h.p;
+            node *c = plan(t->child);
+            if (t == root) {
+                // the old root stays on top if it still beats all of its children.
+                if (c == nullptr || !Compare()(e, c->data)) {
+                    t->data = e;
+                    return;
+                }
+                t->data = e;
+                c = relink();
+                t->child = nullptr;
+                attach(c, t);
+                root = c;
+                return;
+            }
+            // the root beats the old value, so it beats e and all of t's children.
+            t->data = e;
+            cut(t);
+            c = relink();
+            t->child = nullptr;
+            if (c != nullptr) attach(root, c);
+            attach(root, t);
+        }
+
+        /**
+         * removes h's element; its children are combined in its place,
+         * O(log n) amortized.
+         * if Compare throws, the heap is left unchanged.
+         */
+        void erase(handle h) {
+            node *t = h.p;
+            if (t == root) {
+                pop();
+                return;
+            }
+            node *c = combine(t->child);
+            cut(t);
+            if (c != nullptr) attach(root, c);
+            destroy(t);
+            size1--;
+        }
+
+        /**
+         * calls f on every element, in no particular order.
+         */
+        template<class F>
+        void for_each(F f) const {
+            if (root == nullptr) return;
+            node **stack = new node *[size1];
+            size_t top = 0;
+            stack[top++] = root;
+            try {
+                while (top > 0) {
+                    node *t = stack[--top];
+                    f(static_cast<const T &>(t->data));
+                    if (t->next) stack[top++] = t->next;
+                    if (t->child) stack[top++] = t->child;
+                }
+            } catch (...) {
+                delete[] stack;
+                throw;
+            }
+            delete[] stack;
+        }
+
+        /**
+         * builds bottom-up like leftist_heap::assign, linking instead of merging.
+         * if gen or Compare throws, the heap is left unchanged.
+         */
+        template<class Gen>
+        void assign(size_t n, Gen gen) {
+            // the sizes of the heaps on the stack are distinct powers of two.
+            node *stack[66];
+            size_t k = 0;
+            try {
+                for (size_t i = 1; i <= n; ++i) {
+                    stack[k++] = create(gen());
+                    for (size_t c = i; c % 2 == 0; c /= 2) {
+                        stack[k - 2] = link(stack[k - 2], stack[k - 1]);
+                        --k;
+                    }
+                }
+                for (; k > 1; --k) stack[k - 2] = link(stack[k - 2], stack[k - 1]);
+            } catch (...) {
+                // a failed link leaves both heaps intact on the stack.
+                for (size_t j = 0; j < k; ++j) clear(stack[j]);
+                throw;
+            }
+            node *t = k > 0 ? stack[0] : nullptr;
+            clear(root);
+            root = t;
+            size1 = n;
+        }
+    };
+}
+
+#endif
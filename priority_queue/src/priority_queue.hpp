@@ -3,139 +3,76 @@
 
 #include <cstddef>
 #include <functional>
+#include <iostream>
+#include <type_traits>
 #include "exceptions.hpp"
+#include "dary_heap.hpp"
+#include "leftist_heap.hpp"
+#include "pairing_heap.hpp"
+#include "serialize.hpp"
 
 namespace sjtu {
 
 /**
  * a container like std::priority_queue which is a heap internal.
+ *
+ * Heap chooses the heap behind it:
+ *
+ *   leftist_heap    the default: O(log n) push, pop and merge (leftist_heap.hpp)
+ *   pairing_heap    O(1) push and merge, O(log n) amortized pop (pairing_heap.hpp)
+ *   dary_heap<D>    an implicit array heap: cache-friendly push and pop (dary_heap.hpp)
+ *
+ * the node-based backends keep every promise made below. dary_heap does
+ * not keep two of them, and is meant for queues that are rarely merged:
+ * its merge and push_range cost O(m log n) for a smaller queue of m, well
+ * past the O(log n) bound, and give only the basic guarantee, since if
+ * Compare throws some elements may already have moved from one queue to
+ * the other. Both queues stay valid and nothing leaks.
+ *
+ * for example sjtu::priority_queue<int, std::less<int>, sjtu::dary_heap<4>>.
+ * benchmark/merge.cpp times them against each other.
+ *
+ * with the node-based backends, push returns a handle to the new element
+ * that stays valid until it is popped or erased (merge moves it along), and
+ * update, increase_key, decrease_key and erase act on the element it names.
+ * "increase" means moving towards the top as Compare ranks elements: with
+ * std::greater, as in Dijkstra's algorithm, a shorter distance is an increase.
  */
-    template<typename T, class Compare = std::less<T>>
+    template<typename T, class Compare = std::less<T>, class Heap = leftist_heap>
     class priority_queue {
     private:
-        struct node {
-            T *data;
-            node *left, *right;
-            int npl;
-
-            node() {
-                data = nullptr;
-                left = nullptr;
-                right = nullptr;
-                npl = 0;
-            }
-
-            ~node() {
-                delete data;
-                data = nullptr;
-                left = nullptr;
-                right = nullptr;
-                npl = 0;
-            }
+        using impl_type = typename Heap::template heap<T, Compare>;
 
-            bool operator<(const node &other) {
-                return !Compare()(*data , *(other.data));
-            }
-        };
-
-        node *root;
-        size_t size1;
-
-        node *merge(node *l, node *r) {
-            if (l == nullptr) return r;
-            if (r == nullptr) return l;
-            node* tmp;
-            if (*l < *r) tmp= merge1(l, r);
-            else tmp= merge1(r, l);
-            //delete r;
-            return tmp;
-        }
-
-        void swapChildren(node *t) {
-            node *tmp;
-            tmp = t->left;
-            t->left = t->right;
-            t->right = tmp;
-        }
-
-        node *merge1(node *l, node *r) {
-            if (l->left == nullptr) { l->left = r; }
-            else {
-                l->right = merge(l->right, r);
-                if (l->left->npl < l->right->npl)
-                    swapChildren(l);
-                l->npl = l->right->npl + 1;
-            }
-            return l;
-        }
-
-        node *build(node *t, node *other) {
-            if (other == nullptr) {
-                return nullptr;
-            }
-            t = new node;
-            if(t->data== nullptr) t->data=new T(*(other->data));
-            else *(t->data) = *(other->data);
-            t->npl = other->npl;
-            t->left = build(t->left, other->left);
-            t->right = build(t->right, other->right);
-            return t;
-        }
-
-        /*void Copy(BiTree t,BiTree &newt){
-            if(t==NULL){
-                newt = NULL;
-                return;
-            }
-            else{
-                newt = new BiTNode;
-                newt->data = t->data;
-                Copy(t->lchild,newt->lchild);
-                Copy(t->rchild,newt->rchild);
-            }
-        }*/
-
-        void clear(node *t) {
-            if (t == nullptr) return;
-            clear(t->left);
-            clear(t->right);
-            delete t;
-            t = nullptr;
-        }
+        impl_type impl;
 
     public:
+        using handle = typename impl_type::handle;
+
         /**
          * TODO constructors
          */
-        priority_queue() {
-            root = nullptr;
-            size1 = 0;
-        }
+        priority_queue() = default;
+
+        priority_queue(const priority_queue &other) = default;
 
-        priority_queue(const priority_queue &other) {
-            root = build(root, other.root);
-            size1 = other.size1;
+        /**
+         * a queue of the elements of [first, last), built bottom-up with O(n)
+         * comparisons instead of n pushes; see push_range.
+         */
+        template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        priority_queue(InputIt first, InputIt last) {
+            impl.assign(distance(first, last), next(first));
         }
 
         /**
          * TODO deconstructor
          */
-        ~priority_queue() {
-            clear(root);
-            root = nullptr;
-            size1 = 0;
-        }
+        ~priority_queue() = default;
 
         /**
          * TODO Assignment operator
          */
-        priority_queue &operator=(const priority_queue &other) {
-            if (this==&other) return *this;
-            clear(root);
-            root= build(root,other.root);
-            size1=other.size1;
-            return *this;
-        }
+        priority_queue &operator=(const priority_queue &other) = default;
 
         /**
          * get the top of the queue.
@@ -144,25 +81,17 @@ namespace sjtu {
          */
         const T &top() const {
             if (empty()) { throw container_is_empty(); }
-            return *(root->data);
+            return impl.top();
         }
 
         /**
          * TODO
          * push new element to the priority queue.
+         * returns its handle, or nothing with dary_heap.
+         * throw runtime_error if Compare throws; the queue is left unchanged.
          */
-        void push(const T &e) {
-            //auto p1 = new node(e);
-            auto p1 = new node;
-            p1->data = new T(e);
-            try {
-                root = merge(p1, root);
-            }
-            catch (...){
-                delete p1;
-                throw runtime_error();
-            }
-            size1++;
+        auto push(const T &e) {
+            return impl.push(e);
         }
 
         /**
@@ -172,17 +101,30 @@ namespace sjtu {
          */
         void pop() {
             if (empty()) throw container_is_empty();
-            auto tmp = root;
-            root = merge(root->left, root->right);
-            delete tmp;
-            size1--;
+            impl.pop();
+        }
+
+        /**
+         * adds a copy of every element of [first, last).
+         * first and last must be forward iterators. The m new elements are built
+         * into a heap of their own bottom-up, with O(m) comparisons, and that
+         * heap is merged in: O(m + log n) in all, but O(m log n) with dary_heap.
+         * if copying an element or Compare throws, the queue is left unchanged;
+         * with dary_heap a throwing Compare leaves it valid but holding an
+         * unspecified part of its old and new elements.
+         */
+        template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        void push_range(InputIt first, InputIt last) {
+            impl_type part;
+            part.assign(distance(first, last), next(first));
+            impl.merge(part);
         }
 
         /**
          * return the number of the elements.
          */
         size_t size() const {
-            return size1;
+            return impl.size();
         }
 
         /**
@@ -190,19 +132,108 @@ namespace sjtu {
          * @return true if it is empty, false if it has at least an element.
          */
         bool empty() const {
-            return root == nullptr;
+            return impl.empty();
         }
 
         /**
-         * merge two priority_queues with at most O(logn) complexity.
-         * clear the other priority_queue.
+         * merge two priority_queues with at most O(logn) complexity,
+         * O(1) with pairing_heap. clear the other priority_queue.
+         * if Compare throws, both are left unchanged. dary_heap keeps neither
+         * promise: see the class comment.
          */
         void merge(priority_queue &other) {
-            if (this == &other) return;
-            root = merge(root, other.root);
-            //delete other.root;
-            other.root = nullptr;
-            size1 += other.size1;
+            impl.merge(other.impl);
+        }
+
+        /**
+         * the element of h.
+         * throw invalid_iterator if h is a default-constructed handle.
+         */
+        const T &get(handle h) const {
+            if (h == handle()) throw invalid_iterator();
+            return impl.get(h);
+        }
+
+        /**
+         * gives the element of h the value e, moving it up or down as needed.
+         * if Compare throws, the queue is left unchanged.
+         */
+        void update(handle h, const T &e) {
+            if (h == handle()) throw invalid_iterator();
+            if (Compare()(impl.get(h), e)) {
+                impl.increase_key(h, e);
+            } else {
+                impl.decrease_key(h, e);
+            }
+        }
+
+        /**
+         * like update for an e that Compare does not rank below the old value;
+         * cheaper, and the queue is undefined if e breaks that rule.
+         */
+        void increase_key(handle h, const T &e) {
+            if (h == handle()) throw invalid_iterator();
+            impl.increase_key(h, e);
+        }
+
+        /**
+         * like update for an e that Compare does not rank above the old value;
+         * the queue is undefined if e breaks that rule.
+         */
+        void decrease_key(handle h, const T &e) {
+            if (h == handle()) throw invalid_iterator();
+            impl.decrease_key(h, e);
+        }
+
+        /**
+         * removes the element of h.
+         * throw invalid_iterator if h is a default-constructed handle.
+         * if Compare throws, the queue is left unchanged.
+         */
+        void erase(handle h) {
+            if (h == handle()) throw invalid_iterator();
+            impl.erase(h);
+        }
+
+        /**
+         * writes a binary snapshot of the elements to os; see serialize.hpp.
+         * the snapshot does not depend on Heap.
+         * throw runtime_error if os fails.
+         */
+        void save(std::ostream &os) const {
+            snapshot_header('Q', 0, snapshot_size<T>(), impl.size()).save(os);
+            impl.for_each([&os](const T &x) { serializer<T>::save(os, x); });
+        }
+
+        /**
+         * replaces the elements with those of a snapshot written by save.
+         * the heap is built bottom-up, which takes O(n) comparisons instead of
+         * the O(n log n) of n pushes.
+         * throw runtime_error if is does not hold such a snapshot; if that or
+         * Compare throws, the queue is left unchanged.
+         */
+        void load(std::istream &is) {
+            size_t n = snapshot_count(is, snapshot_header::load(is, snapshot_header('Q', 0, snapshot_size<T>(), 0)),
+                                      snapshot_size<T>());
+            impl.assign(n, [&is]() { return serializer<T>::load(is); });
+        }
+
+    private:
+        template<typename InputIt>
+        static size_t distance(InputIt first, InputIt last) {
+            size_t n = 0;
+            for (; first != last; ++first) ++n;
+            return n;
+        }
+
+        // a generator for assign that yields *first and moves first along.
+        template<typename InputIt>
+        static auto next(InputIt &first) {
+            return [&first]() -> decltype(*first) {
+                InputIt it = first;
+                ++first;
+                return *it;
+            };
         }
     };
 
@@ -0,0 +1,178 @@
+#ifndef SJTU_SERIALIZE_HPP
+#define SJTU_SERIALIZE_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+namespace sjtu {
+/**
+ * how one element is written to and read back from a binary snapshot.
+ *
+ * trivially copyable types are handled here: their bytes are written as they
+ * are, and containers copy whole runs of them as one block. Any other type
+ * needs a specialization with a save and a load function, for example
+ *
+ *   namespace sjtu {
+ *       template<>
+ *       struct serializer<Util::Bint> {
+ *           static void save(std::ostream &os, const Util::Bint &x) { ... }
+ *           static Util::Bint load(std::istream &is) { ... }
+ *       };
+ *   }
+ *
+ * snapshots use the native byte order, so they are meant to be read back on
+ * the same kind of machine.
+ */
+    template<typename T, typename = void>
+    struct serializer;
+
+    /**
+     * writes n raw bytes; throw runtime_error if the stream fails.
+     */
+    inline void write_bytes(std::ostream &os, const void *p, size_t n) {
+        if (!os.write(static_cast<const char *>(p), std::streamsize(n))) throw runtime_error();
+    }
+
+    /**
+     * reads exactly n raw bytes; throw runtime_error if the stream ends early.
+     */
+    inline void read_bytes(std::istream &is, void *p, size_t n) {
+        if (!is.read(static_cast<char *>(p), std::streamsize(n))) throw runtime_error();
+    }
+
+    template<typename T>
+    struct serializer<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type> {
+        static constexpr bool raw = true;
+
+        static void save(std::ostream &os, const T &x) {
+            write_bytes(os, &x, sizeof(T));
+        }
+
+        static T load(std::istream &is) {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type bytes;
+            read_bytes(is, &bytes, sizeof(T));
+            return *reinterpret_cast<T *>(&bytes);
+        }
+    };
+
+    /**
+     * strings are written as their length followed by their characters.
+     */
+    template<>
+    struct serializer<std::string> {
+        static void save(std::ostream &os, const std::string &x) {
+            std::uint64_t n = x.size();
+            write_bytes(os, &n, sizeof(n));
+            write_bytes(os, x.data(), x.size());
+        }
+
+        static std::string load(std::istream &is) {
+            std::uint64_t n;
+            read_bytes(is, &n, sizeof(n));
+            std::string x(size_t(n), '\0');
+            read_bytes(is, &x[0], x.size());
+            return x;
+        }
+    };
+
+    /**
+     * whether containers may copy runs of T as one block of bytes: true for
+     * trivially copyable types, unless a specialization of serializer says otherwise.
+     */
+    template<typename T, typename = void>
+    struct is_raw_serializable : std::false_type {};
+
+    template<typename T>
+    struct is_raw_serializable<T, typename std::enable_if<serializer<T>::raw>::type> : std::true_type {};
+
+    /**
+     * every snapshot starts with this header. elemSize is sizeof(T) when the
+     * elements are stored raw and 0 otherwise, so a snapshot is never read back
+     * into elements of a different layout.
+     */
+    struct snapshot_header {
+        char magic[4];
+        char kind;
+        unsigned char version;
+        char reserved[2];
+        std::uint32_t keySize;
+        std::uint32_t elemSize;
+        std::uint64_t count;
+
+        static constexpr unsigned char currentVersion = 1;
+
+        snapshot_header() : magic{'S', 'J', 'T', 'U'}, kind(0), version(currentVersion), reserved{0, 0},
+                            keySize(0), elemSize(0), count(0) {}
+
+        snapshot_header(char kind, std::uint32_t keySize, std::uint32_t elemSize, std::uint64_t count)
+                : snapshot_header() {
+            this->kind = kind;
+            this->keySize = keySize;
+            this->elemSize = elemSize;
+            this->count = count;
+        }
+
+        void save(std::ostream &os) const {
+            write_bytes(os, this, sizeof(*this));
+        }
+
+        /**
+         * reads a header and checks it against expected; returns the element count.
+         * throw runtime_error on a mismatch.
+         */
+        static std::uint64_t load(std::istream &is, const snapshot_header &expected) {
+            snapshot_header h;
+            read_bytes(is, &h, sizeof(h));
+            for (int i = 0; i < 4; ++i) {
+                if (h.magic[i] != expected.magic[i]) throw runtime_error();
+            }
+            if (h.kind != expected.kind || h.version != expected.version || h.keySize != expected.keySize ||
+                h.elemSize != expected.elemSize) {
+                throw runtime_error();
+            }
+            return h.count;
+        }
+    };
+
+    /**
+     * the number of bytes left to read in is, or size_t(-1) if it cannot seek.
+     */
+    inline size_t bytes_left(std::istream &is) {
+        std::streambuf *sb = is.rdbuf();
+        if (sb == nullptr) return size_t(-1);
+        std::streampos here = sb->pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+        if (here == std::streampos(-1)) return size_t(-1);
+        std::streampos end = sb->pubseekoff(0, std::ios_base::end, std::ios_base::in);
+        sb->pubseekpos(here, std::ios_base::in);
+        if (end == std::streampos(-1) || end < here) return size_t(-1);
+        return size_t(end - here);
+    }
+
+    /**
+     * checks the count of a header just read from is, for elements that take
+     * at least minBytes bytes each: they must fit in memory and, if is can
+     * seek, in what is left of it. throw runtime_error otherwise.
+     */
+    inline size_t snapshot_count(std::istream &is, std::uint64_t n, size_t minBytes) {
+        if (n > std::uint64_t(size_t(-1))) throw runtime_error();
+        if (minBytes > 0 && (size_t(n) > size_t(-1) / minBytes || size_t(n) * minBytes > bytes_left(is))) {
+            throw runtime_error();
+        }
+        return size_t(n);
+    }
+
+    /**
+     * the size recorded in the header for elements of type T.
+     */
+    template<typename T>
+    constexpr std::uint32_t snapshot_size() {
+        return is_raw_serializable<T>::value ? std::uint32_t(sizeof(T)) : 0;
+    }
+}
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * times the copy constructor against the parallel one on large vectors.
+ *
+ *   g++ -std=c++17 -O2 -I ../src parallel.cpp -o parallel && ./parallel
+ */
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+template<class F>
+double Time(F f)
+{
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double, std::milli> d = std::chrono::steady_clock::now() - start;
+	return d.count();
+}
+
+template<typename T>
+void Bench(const char *name, const sjtu::vector<T> &v)
+{
+	double serial = Time([&] { sjtu::vector<T> copy(v); });
+	double parallel = Time([&] { sjtu::vector<T> copy(sjtu::parallel, v); });
+	std::printf("%-8s %10zu %10.1f ms %10.1f ms %6.2fx\n", name, v.size(), serial, parallel, serial / parallel);
+}
+
+int main()
+{
+	std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+	std::printf("%-8s %10s %13s %13s %7s\n", "type", "elements", "copy", "parallel", "speedup");
+	sjtu::vector<long long> ints;
+	for (long long i = 0; i < 50000000; ++i) {
+		ints.push_back(i);
+	}
+	Bench("int64", ints);
+	sjtu::vector<std::string> strings;
+	for (int i = 0; i < 5000000; ++i) {
+		strings.push_back(std::string(40, char('a' + i % 26)));
+	}
+	Bench("string", strings);
+	double serial = Time([&] { sjtu::vector<long long> v; for (int i = 0; i < 50000000; ++i) v.push_back(7); });
+	double parallel = Time([&] { sjtu::vector<long long> v(sjtu::parallel, 50000000, 7); });
+	std::printf("%-8s %10d %10.1f ms %10.1f ms %6.2fx\n", "fill", 50000000, serial, parallel, serial / parallel);
+	return 0;
+}
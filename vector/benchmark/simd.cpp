@@ -0,0 +1,137 @@
+/**
+ * compares the vectorized kernels of simd.hpp with the plain loops they replace.
+ *
+ *   g++ -std=c++17 -O2 -I ../src simd.cpp -o simd && ./simd
+ *   g++ -std=c++17 -O2 -mavx2 -I ../src simd.cpp -o simd && ./simd
+ *
+ * the plain loops are compiled with vectorization off, so that they show what
+ * the kernels gain over the element-by-element loops in vector.hpp.
+ * every line prints the time per call of both versions and the speedup.
+ */
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+namespace scalar {
+#define SCALAR __attribute__((noinline, optimize("no-tree-vectorize")))
+
+    template<typename T>
+    SCALAR const T *find(const T *first, const T *last, const T &value) {
+        for (; first != last; ++first) {
+            if (*first == value) return first;
+        }
+        return last;
+    }
+
+    template<typename T>
+    SCALAR size_t count(const T *first, const T *last, const T &value) {
+        size_t cnt = 0;
+        for (; first != last; ++first) {
+            if (*first == value) ++cnt;
+        }
+        return cnt;
+    }
+
+    template<typename T>
+    SCALAR const T *min_element(const T *first, const T *last) {
+        const T *low = first;
+        for (++first; first != last; ++first) {
+            if (*first < *low) low = first;
+        }
+        return low;
+    }
+
+    template<typename T>
+    SCALAR void fill(T *first, T *last, const T &value) {
+        for (; first != last; ++first) *first = value;
+    }
+
+    template<typename T>
+    SCALAR bool equal(const T *a, const T *b, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            if (!(a[i] == b[i])) return false;
+        }
+        return true;
+    }
+
+    SCALAR size_t popcount(const std::uint64_t *words, size_t n) {
+        size_t cnt = 0;
+        for (size_t i = 0; i < n; ++i) cnt += size_t(__builtin_popcountll(words[i]));
+        return cnt;
+    }
+}
+
+volatile size_t sink;
+
+template<class F>
+double Time(F f, int rounds)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < rounds; ++i) {
+		f();
+	}
+	std::chrono::duration<double, std::micro> d = std::chrono::steady_clock::now() - start;
+	return d.count() / rounds;
+}
+
+template<typename T>
+void Bench(const char *name, size_t n, int rounds)
+{
+	sjtu::vector<T> v, w;
+	for (size_t i = 0; i < n; ++i) {
+		v.push_back(T(i % 100 + 1));
+		w.push_back(T(i % 100 + 1));
+	}
+	v[n - 1] = w[n - 1] = T(0);
+	const T *b = v.data(), *e = v.data() + n;
+	T *wb = w.data(), *we = w.data() + n;
+	T key = T(0), five = T(5);
+	auto report = [&](const char *op, double s, double k) {
+		std::printf("%-8s %-10s %10.1f us %10.1f us %6.2fx\n", name, op, s, k, s / k);
+	};
+	report("find", Time([&] { sink = scalar::find(b, e, key) - b; }, rounds),
+		   Time([&] { sink = sjtu::find(v, key) - v.begin(); }, rounds));
+	report("count", Time([&] { sink = scalar::count(b, e, five); }, rounds),
+		   Time([&] { sink = sjtu::count(v, five); }, rounds));
+	report("min", Time([&] { sink = scalar::min_element(b, e) - b; }, rounds),
+		   Time([&] { sink = sjtu::min_element(v) - v.begin(); }, rounds));
+	report("==", Time([&] { sink = scalar::equal(b, (const T *) wb, n); }, rounds),
+		   Time([&] { sink = v == w; }, rounds));
+	report("fill", Time([&] { scalar::fill(wb, we, five); sink = size_t(wb[n / 2]); }, rounds),
+		   Time([&] { sjtu::fill(w, five); sink = size_t(wb[n / 2]); }, rounds));
+}
+
+// counts the set bits of a packed vector<bool> of n elements.
+void BenchBits(size_t n, int rounds)
+{
+	sjtu::vector<bool> v;
+	for (size_t i = 0; i < n; ++i) {
+		v.push_back(i % 3 == 0);
+	}
+	const std::uint64_t *words = v.data();
+	double s = Time([&] { sink = scalar::popcount(words, n / 64); }, rounds);
+	double k = Time([&] { sink = v.count(); }, rounds);
+	std::printf("%-8s %-10s %10.1f us %10.1f us %6.2fx\n", "bool", "count", s, k, s / k);
+}
+
+int main()
+{
+	const size_t n = 1 << 20;
+#if defined(SJTU_SIMD_AVX2)
+	std::printf("kernels: AVX2, %zu elements\n", n);
+#elif defined(SJTU_SIMD_SSE2)
+	std::printf("kernels: SSE2, %zu elements\n", n);
+#else
+	std::printf("kernels: scalar, %zu elements\n", n);
+#endif
+	std::printf("%-8s %-10s %13s %13s %7s\n", "type", "op", "plain loop", "kernel", "speedup");
+	Bench<signed char>("int8", n, 200);
+	Bench<short>("int16", n, 200);
+	Bench<int>("int32", n, 100);
+	Bench<long long>("int64", n, 50);
+	Bench<float>("float", n, 100);
+	Bench<double>("double", n, 50);
+	BenchBits(n * 64, 50);
+	return 0;
+}
@@ -0,0 +1,163 @@
+#include "vector.hpp"
+
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <string>
+
+unsigned long long seed = 19260817;
+
+unsigned long long next()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+// compares every kernel with a plain loop on all lengths up to 100 and at every offset.
+template<typename T>
+bool Check(T (*gen)())
+{
+	bool ok = true;
+	for (int n = 0; n <= 100; ++n) {
+		sjtu::vector<T> v;
+		for (int i = 0; i < n; ++i) {
+			v.push_back(gen());
+		}
+		for (int i = 0; i < n; ++i) {
+			T x = v[i];
+			size_t cnt = 0, first = n;
+			for (int j = 0; j < n; ++j) {
+				if (v[j] == x) {
+					++cnt;
+					if (first == size_t(n)) first = j;
+				}
+			}
+			ok = ok && size_t(sjtu::find(v, x) - v.begin()) == first && sjtu::count(v, x) == cnt;
+		}
+		T missing = gen();
+		size_t cnt = 0;
+		for (int j = 0; j < n; ++j) {
+			if (v[j] == missing) ++cnt;
+		}
+		ok = ok && sjtu::count(v, missing) == cnt;
+		size_t low = 0;
+		for (int j = 1; j < n; ++j) {
+			if (v[j] < v[low]) low = j;
+		}
+		ok = ok && size_t(sjtu::min_element(v) - v.begin()) == (n == 0 ? 0 : low);
+		sjtu::vector<T> w(v);
+		ok = ok && w == v && !(w != v);
+		if (n > 0) {
+			w[next() % n] = T(w[n - 1] + 1);
+			ok = ok && (w == v) == (w[n - 1] == v[n - 1] && w[0] == v[0] && !(w != v));
+			w.pop_back();
+			ok = ok && w != v;
+		}
+		T value = gen();
+		sjtu::fill(v, value);
+		ok = ok && sjtu::count(v, value) == size_t(n);
+	}
+	return ok;
+}
+
+signed char GenChar() { return next() % 7 - 3; }
+unsigned char GenUChar() { return next() % 5 * 60; }
+short GenShort() { return next() % 9 - 4; }
+int GenInt() { return next() % 11 - 5; }
+unsigned GenUnsigned() { return next() % 13 * 400000000u; }
+long long GenLong() { return (long long) (next() % 6) << 40 | (next() % 3); }
+unsigned long long GenULong() { return next() % 5 * 4000000000000000000ull; }
+float GenFloat() { return float(int(next() % 9) - 4) / 2; }
+double GenDouble() { return double(int(next() % 9) - 4) / 4; }
+
+void TestKernels()
+{
+	std::cout << "Testing vectorized kernels..." << std::endl;
+	std::cout << Check(GenChar) << Check(GenUChar) << Check(GenShort) << Check(GenInt) << Check(GenUnsigned)
+			  << Check(GenLong) << Check(GenULong) << Check(GenFloat) << Check(GenDouble) << std::endl;
+}
+
+void TestFloat()
+{
+	std::cout << "Testing floating point corner cases..." << std::endl;
+	double nan = 0.0 / 0.0;
+	sjtu::vector<double> v;
+	for (int i = 0; i < 40; ++i) {
+		v.push_back(i % 10 == 3 ? nan : i * 0.5);
+	}
+	v.push_back(-0.0);
+	std::cout << (sjtu::find(v, nan) - v.begin()) << " " << sjtu::count(v, nan) << " "
+			  << (sjtu::find(v, 0.0) - v.begin()) << " " << sjtu::count(v, 0.0) << std::endl;
+	sjtu::vector<double> w(v);
+	std::cout << (w == v) << std::endl;
+	for (int i = 0; i < 4; ++i) {
+		v[3 + 10 * i] = w[3 + 10 * i] = 1;
+	}
+	std::cout << (w == v) << " " << *sjtu::min_element(v) << std::endl;
+	sjtu::vector<float> f;
+	for (int i = 0; i < 1000; ++i) {
+		f.push_back(1.5f);
+	}
+	f[777] = -2.5f;
+	f[999] = -2.5f;
+	std::cout << (sjtu::min_element(f) - f.begin()) << " " << sjtu::count(f, 1.5f) << std::endl;
+	// the value converts to the element type.
+	sjtu::fill(w, 0);
+	w[5] = 1;
+	std::cout << sjtu::count(w, 0) << " " << (sjtu::find(w, 1) - w.begin()) << " " << sjtu::count(f, 2) << std::endl;
+}
+
+void TestLarge()
+{
+	std::cout << "Testing large vectors..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 1000000; ++i) {
+		v.push_back(int(next() % 1000000));
+	}
+	v[654321] = -1;
+	std::cout << (sjtu::find(v, -1) - v.begin()) << " " << sjtu::count(v, -1) << " "
+			  << (sjtu::min_element(v) - v.begin()) << std::endl;
+	const sjtu::vector<int> &cv = v;
+	std::cout << (sjtu::find(cv, 1000000) == cv.end()) << std::endl;
+	sjtu::fill(v, 42);
+	std::cout << sjtu::count(v, 42) << std::endl;
+	sjtu::vector<unsigned char> bytes;
+	for (int i = 0; i < 100000; ++i) {
+		bytes.push_back(255);
+	}
+	bytes[99999] = 0;
+	std::cout << (sjtu::min_element(bytes) - bytes.begin()) << " " << sjtu::count(bytes, (unsigned char) 255) << std::endl;
+}
+
+void TestFallback()
+{
+	std::cout << "Testing other element types..." << std::endl;
+	sjtu::vector<Util::Bint> v;
+	for (int i = 0; i < 50; ++i) {
+		v.push_back(Util::Bint(i % 7) * Util::Bint(1000000000) * Util::Bint(1000000000));
+	}
+	std::cout << (sjtu::find(v, Util::Bint(0)) - v.begin()) << " " << sjtu::count(v, v[3]) << " "
+			  << (sjtu::min_element(v) - v.begin()) << std::endl;
+	sjtu::vector<Util::Bint> w(v);
+	std::cout << (w == v) << std::endl;
+	sjtu::fill(w, Util::Bint(5));
+	std::cout << (w == v) << " " << w[49] << std::endl;
+	sjtu::vector<std::string> s;
+	sjtu::small_vector<std::string, 4> t;
+	for (int i = 0; i < 3; ++i) {
+		s.push_back("a");
+		t.push_back("a");
+	}
+	std::cout << (s == t) << " " << sjtu::count(t, std::string("a")) << std::endl;
+}
+
+int main()
+{
+	TestKernels();
+	TestFloat();
+	TestLarge();
+	TestFallback();
+	return 0;
+}
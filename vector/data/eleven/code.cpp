@@ -0,0 +1,104 @@
+#include "mmap_vector.hpp"
+
+#include <cstdio>
+#include <iostream>
+
+struct Record {
+	int id;
+	double score;
+	char tag[4];
+};
+
+const char *path = "mmap_vector_test.bin";
+
+void TestCreate()
+{
+	std::cout << "Testing file creation..." << std::endl;
+	std::remove(path);
+	sjtu::mmap_vector<Record> v(path);
+	std::cout << v.size() << " " << v.empty() << " " << v.capacity() << std::endl;
+	for (int i = 0; i < 1000000; ++i) {
+		v.push_back(Record{i, i * 0.25, {char('a' + i % 26), 0, 0, 0}});
+	}
+	v.pop_back();
+	v.emplace_back(Record{-1, -1.0, {'z', 0, 0, 0}});
+	v.push_back(v[0]);
+	std::cout << v.size() << " " << v.back().id << " " << v.at(999999).id << " " << v[123456].score << " " << v[27].tag << std::endl;
+	long long sum = 0;
+	for (sjtu::mmap_vector<Record>::iterator it = v.begin(); it != v.end(); ++it) {
+		sum += it->id;
+	}
+	std::cout << sum << " " << (v.end() - v.begin()) << std::endl;
+	v.sync();
+}
+
+void TestReopen()
+{
+	std::cout << "Testing reopening..." << std::endl;
+	sjtu::mmap_vector<Record> v(path);
+	const sjtu::mmap_vector<Record> &cv = v;
+	std::cout << cv.size() << " " << cv.front().id << " " << cv[500000].score << " " << cv.at(1000000).id << std::endl;
+	v[0].id = 42;
+	v.shrink_to_fit();
+	std::cout << (v.capacity() == v.size()) << std::endl;
+	v.push_back(Record{7, 7.0, {'q', 0, 0, 0}});
+	sjtu::mmap_vector<Record> moved(std::move(v));
+	std::cout << moved.size() << " " << moved.back().id << std::endl;
+	// the moved-from vector has no file left.
+	v.clear();
+	std::cout << v.size() << " " << v.empty() << " " << v.capacity() << " " << (v.begin() == v.end()) << std::endl;
+	try {
+		v.push_back(Record{8, 8.0, {'r', 0, 0, 0}});
+	} catch (sjtu::runtime_error &) {
+		std::cout << "exception thrown" << std::endl;
+	}
+}
+
+void TestReopenAgain()
+{
+	std::cout << "Testing changes persist..." << std::endl;
+	sjtu::mmap_vector<Record> v(path);
+	std::cout << v.size() << " " << v[0].id << " " << v.back().tag << std::endl;
+	v.clear();
+	std::cout << v.size() << std::endl;
+	try {
+		v.pop_back();
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	try {
+		std::cout << v.at(0).id << std::endl;
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+}
+
+void TestMismatch()
+{
+	std::cout << "Testing files of another type..." << std::endl;
+	try {
+		sjtu::mmap_vector<long long> v(path);
+		std::cout << v.size() << std::endl;
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	std::FILE *f = std::fopen(path, "wb");
+	std::fputs("not a vector", f);
+	std::fclose(f);
+	try {
+		sjtu::mmap_vector<Record> v(path);
+		std::cout << v.size() << std::endl;
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	std::remove(path);
+}
+
+int main()
+{
+	TestCreate();
+	TestReopen();
+	TestReopenAgain();
+	TestMismatch();
+	return 0;
+}
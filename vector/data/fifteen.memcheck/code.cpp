@@ -0,0 +1,201 @@
+#include "static_vector.hpp"
+
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <string>
+
+constexpr sjtu::static_vector<int, 16> Squares()
+{
+	sjtu::static_vector<int, 16> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i * i);
+	}
+	v.insert(v.begin() + 2, 3, -1);
+	v.erase(v.begin() + 5);
+	v.push_front(100);
+	v.pop_back();
+	int more[] = {7, 8};
+	v.insert(v.end(), more, more + 2);
+	return v;
+}
+
+constexpr int Sum(const sjtu::static_vector<int, 16> &v)
+{
+	int s = 0;
+	for (int x : v) {
+		s += x;
+	}
+	return s;
+}
+
+constexpr sjtu::static_vector<int, 16> squares = Squares();
+static_assert(squares.size() == 14, "built at compile time");
+static_assert(squares[0] == 100 && squares.back() == 8 && Sum(squares) == 312, "contents at compile time");
+static_assert(sizeof(sjtu::static_vector<int, 16>) == 16 * sizeof(int) + sizeof(size_t), "no heap pointer");
+static_assert(sjtu::static_vector<int, 16>::capacity() == 16, "fixed capacity");
+
+struct Point {
+	int x, y;
+};
+
+void TestTrivial()
+{
+	std::cout << "Testing trivial elements..." << std::endl;
+	for (int x : squares) {
+		std::cout << x << " ";
+	}
+	std::cout << std::endl;
+	sjtu::static_vector<Point, 4> p;
+	p.emplace_back(Point{1, 2});
+	p.push_back({3, 4});
+	p.insert(size_t(0), Point{5, 6});
+	sjtu::static_vector<Point, 4> q(p);
+	q.erase(size_t(1));
+	std::cout << p.size() << " " << p[0].x << p[1].y << p[2].x << " " << q.size() << " " << q.front().x << q.back().y
+			  << std::endl;
+	sjtu::static_vector<int, 8> a(5, 9), b;
+	b.assign(a.begin(), a.end());
+	std::cout << (a == b) << (a != b) << std::endl;
+	b.push_back(1);
+	std::cout << (a == b) << (a != b) << " " << b.size() << std::endl;
+	std::cout << sjtu::static_vector<int, 8>(3, 2).size() << std::endl;
+}
+
+void TestOverflow()
+{
+	std::cout << "Testing overflow..." << std::endl;
+	sjtu::static_vector<int, 4> v;
+	for (int i = 0; i < 4; ++i) {
+		v.push_back(i);
+	}
+	try {
+		v.push_back(4);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "full " << v.size() << std::endl;
+	}
+	try {
+		v.insert(v.begin(), 2, 0);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "full " << v.size() << std::endl;
+	}
+	try {
+		v.reserve(5);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "too big" << std::endl;
+	}
+	try {
+		v.at(4) = 1;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+	try {
+		v.insert(size_t(5), 1);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+	v.clear();
+	try {
+		v.pop_back();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "empty" << std::endl;
+	}
+	int big[] = {1, 2, 3, 4, 5};
+	v.push_back(42);
+	try {
+		v.assign(big, big + 5);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "too many " << v.size() << " " << v[0] << std::endl;
+	}
+}
+
+// counts live objects, and throws on the copy that makes the fuse reach zero.
+struct Fragile {
+	static int alive;
+	static int fuse;
+	std::string s;
+
+	explicit Fragile(const std::string &s) : s(s) { ++alive; }
+
+	Fragile(const Fragile &other) : s(other.s) {
+		if (--fuse == 0) throw std::string("copy failed");
+		++alive;
+	}
+
+	Fragile(Fragile &&other) noexcept : s(std::move(other.s)) { ++alive; }
+
+	Fragile &operator=(const Fragile &other) = default;
+
+	Fragile &operator=(Fragile &&other) noexcept = default;
+
+	~Fragile() { --alive; }
+};
+
+int Fragile::alive = 0;
+int Fragile::fuse = -1;
+
+template<size_t N>
+std::string Join(const sjtu::static_vector<Fragile, N> &v)
+{
+	std::string r;
+	for (const Fragile &f : v) {
+		r += f.s;
+	}
+	return r;
+}
+
+void TestObjects()
+{
+	std::cout << "Testing non-trivial elements..." << std::endl;
+	{
+		sjtu::static_vector<Fragile, 10> v;
+		v.emplace_back("a");
+		v.emplace_back("b");
+		v.emplace(v.begin(), "c");
+		v.insert(v.begin() + 1, 2, Fragile("d"));
+		v.insert(v.begin() + 2, v[0]);
+		std::cout << Join(v) << " " << Fragile::alive << std::endl;
+		Fragile::fuse = 2;
+		try {
+			v.insert(v.begin() + 1, 3, Fragile("e"));
+		} catch (std::string &e) {
+			std::cout << e << " " << Join(v) << " " << Fragile::alive << std::endl;
+		}
+		Fragile::fuse = -1;
+		sjtu::static_vector<Fragile, 10> w(v);
+		w.erase(w.begin() + 1, w.begin() + 4);
+		sjtu::static_vector<Fragile, 10> x(std::move(w));
+		std::cout << Join(x) << " " << w.size() << " " << Fragile::alive << std::endl;
+		x.swap(v);
+		std::cout << Join(x) << " " << Join(v) << std::endl;
+		std::cout << x.retain([](const Fragile &f) { return f.s != "d"; }) << " " << Join(x) << std::endl;
+		x = v;
+		x.pop_front();
+		std::cout << Join(x) << " " << Fragile::alive << std::endl;
+		// a copy constructor that fails halfway destroys the copies it made.
+		Fragile::fuse = 3;
+		try {
+			sjtu::static_vector<Fragile, 10> y(v);
+		} catch (std::string &e) {
+			std::cout << e << " " << Fragile::alive << std::endl;
+		}
+		Fragile::fuse = -1;
+	}
+	std::cout << Fragile::alive << std::endl;
+	sjtu::static_vector<Util::Bint, 3> b;
+	b.push_back(Util::Bint(1000000000) * Util::Bint(1000000000));
+	b.emplace_back(7);
+	b.emplace_back(b[0] * b[1]);
+	std::cout << b[2] << " " << b.size() << std::endl;
+	b.pop_back();
+	sjtu::static_vector<Util::Bint, 3> c(b);
+	std::cout << c.back() << std::endl;
+}
+
+int main()
+{
+	TestTrivial();
+	TestOverflow();
+	TestObjects();
+	return 0;
+}
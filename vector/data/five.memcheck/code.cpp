@@ -0,0 +1,355 @@
+#include "vector.hpp"
+
+#include "class-integer.hpp"
+#include "class-bint.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace sjtu {
+	template<>
+	struct is_trivially_relocatable<Util::Bint> : std::true_type {};
+}
+
+void TestMove()
+{
+	std::cout << "Testing move constructor and move assignment..." << std::endl;
+	sjtu::vector<Util::Bint> v;
+	for (int i = 1; i <= 20; ++i) {
+		v.push_back(Util::Bint(i) * i);
+	}
+	sjtu::vector<Util::Bint> moved(std::move(v));
+	std::cout << v.size() << " " << moved.size() << std::endl;
+	v.push_back(Util::Bint(7));
+	std::cout << v[0] << std::endl;
+	v = std::move(moved);
+	std::cout << v.size() << " " << moved.size() << std::endl;
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestEmplace()
+{
+	std::cout << "Testing emplace functions..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 5; ++i) {
+		v.emplace_back(i + 1, char('a' + i));
+	}
+	v.emplace(v.begin() + 2, "mid");
+	v.emplace(v.begin(), 3, 'z');
+	std::string s = "moved";
+	v.push_back(std::move(s));
+	v.insert(v.begin() + 1, v[4]);
+	for (sjtu::vector<std::string>::iterator it = v.begin(); it != v.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	sjtu::vector<Integer> vInt;
+	for (int i = 0; i < 100; ++i) {
+		vInt.emplace_back(i);
+	}
+	std::cout << vInt.size() << std::endl;
+}
+
+void TestCapacity()
+{
+	std::cout << "Testing reserve and growth policies..." << std::endl;
+	sjtu::vector<int> v;
+	v.reserve(1000);
+	size_t cap = v.capacity();
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i);
+	}
+	std::cout << cap << " " << (v.capacity() == cap) << std::endl;
+	v.reserve(10);
+	std::cout << v.capacity() << std::endl;
+	for (int i = 0; i < 990; ++i) {
+		v.pop_back();
+	}
+	std::cout << v.size() << " " << (v.capacity() < cap) << std::endl;
+	v.shrink_to_fit();
+	std::cout << v.capacity() << " " << v.back() << std::endl;
+	sjtu::vector<int, sjtu::never_shrink> keep;
+	for (int i = 0; i < 1000; ++i) {
+		keep.push_back(i);
+	}
+	cap = keep.capacity();
+	while (!keep.empty()) {
+		keep.pop_back();
+	}
+	std::cout << (keep.capacity() == cap) << std::endl;
+	sjtu::vector<int, sjtu::growth_policy<3, 2, 8>> slow;
+	for (int i = 0; i < 100; ++i) {
+		slow.push_back(i);
+	}
+	std::cout << slow.capacity() << " " << slow[99] << std::endl;
+}
+
+void TestRelocatable()
+{
+	std::cout << "Testing trivially relocatable elements..." << std::endl;
+	std::cout << sjtu::is_trivially_relocatable<int>::value << " "
+		<< sjtu::is_trivially_relocatable<Integer>::value << " "
+		<< sjtu::is_trivially_relocatable<Util::Bint>::value << " "
+		<< sjtu::is_trivially_relocatable<std::string>::value << std::endl;
+	sjtu::vector<Util::Bint> v;
+	for (int i = 0; i < 50; ++i) {
+		v.push_back(Util::Bint(i) * i);
+	}
+	for (int i = 0; i < 10; ++i) {
+		v.insert(v.begin() + 5 * i, Util::Bint(-i));
+	}
+	v.insert(v.begin() + 3, v[40]);
+	for (int i = 0; i < 40; ++i) {
+		v.erase(v.begin() + 7);
+	}
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestRange()
+{
+	std::cout << "Testing range insert, assign and erase..." << std::endl;
+	sjtu::vector<std::string> src;
+	for (int i = 0; i < 8; ++i) {
+		src.push_back(std::string(1, char('A' + i)));
+	}
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 6; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	v.insert(v.begin() + 3, src.cbegin(), src.cend());
+	v.insert(v.begin() + 1, 3, v[0]);
+	v.insert(v.end(), 2, std::string("end"));
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	v.erase(v.begin() + 2, v.begin() + 12);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	sjtu::vector<long long> w;
+	for (long long i = 0; i < 100000; ++i) {
+		w.push_back(i);
+	}
+	sjtu::vector<long long> block;
+	block.assign(w.begin() + 10, w.begin() + 5010);
+	w.insert(w.begin() + 50000, block.begin(), block.end());
+	w.insert(w.begin() + 3, 5, -1LL);
+	std::cout << w.size() << " " << w[3] << " " << w[8] << " " << w[50005] << " " << w[55005] << std::endl;
+	w.erase(w.begin() + 100, w.end() - 100);
+	std::cout << w.size() << " " << w.capacity() << " " << w[99] << " " << w[100] << std::endl;
+	block.assign(w.begin(), w.begin() + 3);
+	std::cout << block.size() << " " << block[2] << std::endl;
+}
+
+void TestRandomAccess()
+{
+	std::cout << "Testing random access iterators..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 20; ++i) {
+		v.push_back((i * 7) % 20);
+	}
+	std::sort(v.begin(), v.end());
+	for (sjtu::vector<int>::iterator it = v.begin(); it < v.end(); it += 2) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	const sjtu::vector<int> &cv = v;
+	sjtu::vector<int>::const_iterator pos = std::lower_bound(cv.begin(), cv.end(), 13);
+	std::cout << *pos << " " << std::distance(cv.begin(), pos) << " " << (pos - cv.cbegin()) << std::endl;
+	sjtu::vector<int>::iterator it = 3 + v.begin();
+	std::cout << it[2] << " " << (it > v.begin()) << " " << (it <= v.begin() + 3) << " " << (v.end() - it) << std::endl;
+	std::cout << (v.data() == &*v.begin()) << " " << (cv.end() == v.end()) << std::endl;
+	int sum = 0;
+	for (int x : cv) {
+		sum += x;
+	}
+	std::cout << sum << std::endl;
+}
+
+void TestSmallVector()
+{
+	std::cout << "Testing small vectors..." << std::endl;
+	sjtu::vector<int> empty;
+	std::cout << empty.capacity() << " " << (sizeof(empty) == 4 * sizeof(size_t)) << std::endl;
+	sjtu::small_vector<std::string, 4> v;
+	const std::string *inlineBuf = v.data();
+	for (int i = 0; i < 4; ++i) {
+		v.push_back(std::string(i + 1, char('a' + i)));
+	}
+	std::cout << v.capacity() << " " << (v.data() == inlineBuf) << std::endl;
+	sjtu::small_vector<std::string, 4> copy(v);
+	v.push_back("spill");
+	std::cout << v.size() << " " << (v.data() == inlineBuf) << std::endl;
+	sjtu::small_vector<std::string, 4> moved(std::move(v));
+	std::cout << v.size() << " " << moved.size() << " " << moved.back() << std::endl;
+	moved.swap(copy);
+	for (size_t i = 0; i < moved.size(); ++i) {
+		std::cout << moved[i] << " ";
+	}
+	std::cout << "| ";
+	for (size_t i = 0; i < copy.size(); ++i) {
+		std::cout << copy[i] << " ";
+	}
+	std::cout << std::endl;
+	copy.erase(copy.begin() + 1, copy.end() - 1);
+	copy.shrink_to_fit();
+	std::cout << copy.size() << " " << copy.capacity() << " " << copy[0] << " " << copy[1] << std::endl;
+	sjtu::small_vector<Util::Bint, 2> vBint;
+	for (int i = 0; i < 10; ++i) {
+		vBint.emplace_back(i * 1000000007LL);
+	}
+	vBint = sjtu::small_vector<Util::Bint, 2>(vBint);
+	while (vBint.size() > 1) {
+		vBint.pop_back();
+	}
+	std::cout << vBint.capacity() << " " << vBint[0] << std::endl;
+}
+
+void TestEraseIf()
+{
+	std::cout << "Testing erase_if and retain..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 1000000; ++i) {
+		v.push_back(i);
+	}
+	size_t removed = erase_if(v, [](int x) { return x % 1000 != 7; });
+	std::cout << removed << " " << v.size() << " " << v.capacity() << " " << v[0] << " " << v[999] << std::endl;
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 20; ++i) {
+		s.push_back(std::string(i % 5 + 1, char('a' + i)));
+	}
+	removed = s.retain([](const std::string &x) { return x.size() % 2 == 1; });
+	for (size_t i = 0; i < s.size(); ++i) {
+		std::cout << s[i] << " ";
+	}
+	std::cout << "(" << removed << ")" << std::endl;
+	sjtu::vector<Util::Bint> vBint;
+	for (int i = 0; i < 12; ++i) {
+		vBint.push_back(Util::Bint(i) * i);
+	}
+	int calls = 0;
+	try {
+		vBint.retain([&calls](const Util::Bint &x) {
+			if (++calls == 8) throw std::string("stop");
+			return x < Util::Bint(10);
+		});
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	for (size_t i = 0; i < vBint.size(); ++i) {
+		std::cout << vBint[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestDeque()
+{
+	std::cout << "Testing push_front and pop_front..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 1000000; ++i) {
+		v.push_front(i);
+	}
+	long long sum = 0;
+	bool ok = true;
+	for (int i = 0; i < 1000000; ++i) {
+		ok = ok && v[i] == 999999 - i && &v[i] == v.data() + i;
+	}
+	std::cout << v.size() << " " << v.front() << " " << v.back() << " " << ok << std::endl;
+	for (int i = 0; i < 999990; ++i) {
+		sum += v.front();
+		v.pop_front();
+	}
+	std::cout << sum << " " << v.size() << " " << v.front() << " " << v.capacity() << std::endl;
+	sjtu::vector<std::string> q;
+	for (int i = 0; i < 100000; ++i) {
+		q.push_back(std::to_string(i));
+		if (i % 3 == 2) q.pop_front();
+		if (i % 7 == 0) q.emplace_front("f" + std::to_string(i));
+	}
+	std::cout << q.size() << " " << q.front() << " " << q.back() << " " << q[q.size() / 2] << std::endl;
+	q.insert(q.begin(), "x");
+	q.erase(q.begin() + 1, q.begin() + 100);
+	q.erase(q.begin());
+	std::cout << q.size() << " " << q.front() << std::endl;
+	sjtu::small_vector<Util::Bint, 4> sv;
+	for (int i = 0; i < 10; ++i) {
+		if (i % 2) sv.push_front(Util::Bint(i)); else sv.push_back(Util::Bint(i));
+		if (i == 5) sv.pop_front();
+	}
+	for (size_t i = 0; i < sv.size(); ++i) {
+		std::cout << sv[i] << " ";
+	}
+	std::cout << std::endl;
+	// appending to an empty vector is not a front insertion.
+	sjtu::vector<int> g;
+	int moves = 0;
+	const int *last = nullptr;
+	for (int i = 0; i < 64; ++i) {
+		g.push_back(i);
+		if (g.data() != last) ++moves;
+		last = g.data();
+	}
+	std::cout << moves << " " << g.capacity() - g.size() << std::endl;
+	// front insertions reuse reserved room instead of reallocating.
+	sjtu::vector<int> r;
+	r.reserve(1000);
+	const int *block = r.data();
+	for (int i = 0; i < 10; ++i) {
+		r.push_back(i);
+	}
+	r.insert(r.begin(), -1);
+	r.push_front(-2);
+	bool inside = r.data() >= block && r.data() + r.size() <= block + 1000;
+	std::cout << r.capacity() << " " << inside << " " << r[0] << " " << r[1] << " " << r[2] << std::endl;
+	for (int i = 10; r.size() < 1000; ++i) {
+		if (i % 2) r.push_back(i); else r.push_front(-i);
+		inside = inside && r.data() >= block && r.data() + r.size() <= block + 1000;
+	}
+	std::cout << r.capacity() << " " << inside << " " << (r.data() == block) << " " << r.front() << " " << r.back() << std::endl;
+	r.push_back(0);
+	std::cout << (r.capacity() > 1000) << " " << r.size() << std::endl;
+	// reserve closes a front gap in the inline buffer.
+	sjtu::small_vector<std::string, 4> gap;
+	sjtu::small_vector<int, 4> igap;
+	for (int i = 0; i < 4; ++i) {
+		gap.push_back(std::string(20, char('a' + i)));
+		igap.push_back(i);
+	}
+	gap.pop_front();
+	gap.pop_front();
+	igap.pop_front();
+	gap.reserve(4);
+	igap.reserve(4);
+	std::cout << gap.capacity() << " " << gap.size() << " " << gap[0][0] << gap[1][0] << " "
+	          << igap.capacity() << " " << igap[0] << igap[1] << igap[2] << std::endl;
+	try {
+		sjtu::vector<int> e;
+		e.pop_front();
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+}
+
+int main()
+{
+	TestMove();
+	TestEmplace();
+	TestCapacity();
+	TestRelocatable();
+	TestRange();
+	TestRandomAccess();
+	TestSmallVector();
+	TestEraseIf();
+	TestDeque();
+	return 0;
+}
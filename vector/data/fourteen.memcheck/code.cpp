@@ -0,0 +1,255 @@
+#include "vector.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+unsigned long long seed = 998244353;
+
+unsigned long long next()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+template<class V>
+bool Same(const V &v, const std::vector<bool> &model)
+{
+	if (v.size() != model.size()) return false;
+	size_t ones = 0;
+	for (size_t i = 0; i < model.size(); ++i) {
+		if (v[i] != model[i]) return false;
+		if (model[i]) ++ones;
+	}
+	return v.count() == ones && v.count(false) == model.size() - ones;
+}
+
+// runs the same random operations on a packed vector and on std::vector<bool>.
+template<class V>
+bool Random(int steps)
+{
+	V v;
+	std::vector<bool> model;
+	bool ok = true;
+	for (int step = 0; step < steps; ++step) {
+		size_t n = model.size();
+		size_t a = n == 0 ? 0 : next() % (n + 1), b = n == 0 ? 0 : next() % (n + 1);
+		if (a > b) std::swap(a, b);
+		bool value = next() % 2;
+		switch (next() % 10) {
+			case 0:
+			case 1:
+			case 2:
+				v.push_back(value);
+				model.push_back(value);
+				break;
+			case 3:
+				if (n != 0) {
+					v.pop_back();
+					model.pop_back();
+				}
+				break;
+			case 4: {
+				size_t count = next() % 150;
+				v.insert(v.begin() + a, count, value);
+				model.insert(model.begin() + a, count, value);
+				break;
+			}
+			case 5:
+				v.erase(v.begin() + a, v.begin() + b);
+				model.erase(model.begin() + a, model.begin() + b);
+				break;
+			case 6:
+				if (value) {
+					v.set(a, b);
+				} else {
+					v.reset(a, b);
+				}
+				for (size_t i = a; i < b; ++i) model[i] = value;
+				break;
+			case 7:
+				if (n != 0) {
+					v[a % n] = !v[a % n];
+					model[a % n] = !model[a % n];
+				}
+				break;
+			case 8: {
+				size_t expect = a;
+				while (expect < n && model[expect] != value) ++expect;
+				if (a == n) expect = n;
+				ok = ok && v.find_first(value, a) == expect;
+				break;
+			}
+			default:
+				if (next() % 8 == 0) {
+					v.flip();
+					model.flip();
+				} else {
+					v.insert(v.begin() + a, value);
+					model.insert(model.begin() + a, value);
+				}
+		}
+		ok = ok && Same(v, model);
+	}
+	V w(v);
+	ok = ok && w == v && Same(w, model);
+	return ok;
+}
+
+// a stream over s that cannot seek, like a pipe.
+struct pipe_buf : std::streambuf {
+	std::string data;
+
+	explicit pipe_buf(const std::string &s) : data(s) {
+		setg(&data[0], &data[0], &data[0] + data.size());
+	}
+};
+
+void TestRandom()
+{
+	std::cout << "Testing random operations..." << std::endl;
+	std::cout << Random<sjtu::vector<bool>>(3000) << Random<sjtu::small_vector<bool, 100>>(3000)
+			  << Random<sjtu::vector<bool, sjtu::never_shrink>>(3000) << std::endl;
+}
+
+void TestProxy()
+{
+	std::cout << "Testing proxy references..." << std::endl;
+	sjtu::vector<bool> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i % 3 == 0);
+	}
+	sjtu::vector<bool>::reference r = v[1];
+	r = true;
+	v[2] = v[0];
+	v.at(9).flip();
+	swap(v[3], v[4]);
+	for (bool b : v) {
+		std::cout << b;
+	}
+	std::cout << std::endl;
+	int ones = 0;
+	for (sjtu::vector<bool>::iterator it = v.begin(); it != v.end(); ++it) {
+		if (*it) ++ones;
+		*it = !*it;
+	}
+	const sjtu::vector<bool> &cv = v;
+	std::cout << ones << " " << cv.front() << " " << cv.back() << " " << (cv.end() - cv.begin()) << " "
+			  << (sjtu::find(cv, true) - cv.begin()) << " " << sjtu::count(cv, false) << std::endl;
+	try {
+		v.at(10) = true;
+	} catch (...) {
+		std::cout << "out of bound" << std::endl;
+	}
+	try {
+		v.set(3, 11);
+	} catch (...) {
+		std::cout << "out of bound" << std::endl;
+	}
+	sjtu::vector<bool> e;
+	try {
+		e.pop_back();
+	} catch (...) {
+		std::cout << "empty" << std::endl;
+	}
+	v.push_front(true);
+	v.pop_front();
+	v.pop_front();
+	std::cout << v.size() << " " << sjtu::erase_if(v, [](bool b) { return b; }) << " " << v.count(false) << std::endl;
+}
+
+void TestLarge()
+{
+	std::cout << "Testing large bitmaps..." << std::endl;
+	sjtu::vector<bool> v;
+	v.reserve(10000000);
+	std::cout << v.capacity() << std::endl;
+	for (int i = 0; i < 10000000; ++i) {
+		v.push_back(i % 7 == 0);
+	}
+	std::cout << v.count() << " " << v.find_first(true, 5000001) << " " << v.find_first(false, 0) << std::endl;
+	v.set();
+	std::cout << v.count() << " " << v.find_first(false) << std::endl;
+	v.reset(100, 9999900);
+	std::cout << v.count() << " " << v.find_first(true, 100) << std::endl;
+	sjtu::fill(v, false);
+	std::cout << v.count() << " " << (sjtu::find(v, true) == v.end()) << std::endl;
+	v.erase(v.begin() + 1000, v.end());
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+}
+
+void TestCopyAndSnapshot()
+{
+	std::cout << "Testing copies and snapshots..." << std::endl;
+	sjtu::small_vector<bool, 64> s;
+	for (int i = 0; i < 50; ++i) {
+		s.push_back(i % 5 == 1);
+	}
+	sjtu::small_vector<bool, 64> t(std::move(s));
+	std::cout << s.size() << " " << t.size() << " " << t.count() << std::endl;
+	for (int i = 0; i < 100; ++i) {
+		t.push_back(true);
+	}
+	sjtu::vector<bool> u;
+	u.assign(t.begin(), t.end());
+	std::cout << (u == t) << " " << (u != t) << std::endl;
+	t.swap(s);
+	std::cout << s.size() << " " << t.size() << " " << s.count() << std::endl;
+	std::stringstream buf;
+	s.save(buf);
+	sjtu::vector<bool> r;
+	r.push_back(true);
+	r.load(buf);
+	std::cout << (r == s) << " " << r.size() << " " << r.count() << std::endl;
+	std::stringstream bad("nothing");
+	try {
+		r.load(bad);
+	} catch (...) {
+		std::cout << "bad snapshot " << r.size() << std::endl;
+	}
+	// counts that do not fit in memory or in the stream.
+	const std::uint64_t counts[] = {~std::uint64_t(0) - 10, (std::uint64_t(1) << 61) + 1, 1000000};
+	for (std::uint64_t n : counts) {
+		std::string huge = buf.str();
+		std::memcpy(&huge[16], &n, sizeof(n));
+		std::stringstream s1(huge);
+		pipe_buf pb(huge);
+		std::istream s2(&pb);
+		std::istream *streams[] = {&s1, &s2};
+		for (std::istream *in : streams) {
+			try {
+				r.load(*in);
+			} catch (sjtu::runtime_error &) {
+				std::cout << "refused " << r.size() << std::endl;
+			}
+		}
+	}
+	sjtu::vector<bool> big;
+	for (int i = 0; i < 100000; ++i) {
+		big.push_back(i % 7 == 3);
+	}
+	std::stringstream sb;
+	big.save(sb);
+	pipe_buf pb(sb.str());
+	std::istream piped(&pb);
+	r.load(piped);
+	std::cout << (r == big) << " " << r.size() << " " << r.count() << std::endl;
+	s.clear();
+	std::cout << s.empty() << " " << s.count() << std::endl;
+}
+
+int main()
+{
+	TestRandom();
+	TestProxy();
+	TestLarge();
+	TestCopyAndSnapshot();
+	return 0;
+}
@@ -0,0 +1,93 @@
+#include "vector.hpp"
+
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <string>
+
+const sjtu::parallel_t small{1000, 4};
+
+void TestCopy()
+{
+	std::cout << "Testing parallel copy..." << std::endl;
+	sjtu::vector<long long> v;
+	for (long long i = 0; i < 3000000; ++i) {
+		v.push_back(i * i % 1000003);
+	}
+	sjtu::vector<long long> a(sjtu::parallel, v);
+	sjtu::vector<long long> b(small, v);
+	std::cout << a.size() << " " << (a == v) << " " << (b == v) << " " << b.capacity() << std::endl;
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 20000; ++i) {
+		s.push_back(std::to_string(i * 7));
+	}
+	sjtu::vector<std::string> t(small, s);
+	std::cout << t.size() << " " << (t == s) << " " << t[12345] << std::endl;
+	sjtu::vector<int> empty;
+	sjtu::vector<int> e(small, empty);
+	sjtu::small_vector<int, 8> tiny;
+	tiny.push_back(1);
+	sjtu::small_vector<int, 8> tiny2(small, tiny);
+	std::cout << e.size() << " " << tiny2.size() << " " << tiny2.capacity() << std::endl;
+}
+
+void TestFill()
+{
+	std::cout << "Testing parallel fill..." << std::endl;
+	sjtu::vector<Util::Bint> v(small, 5000, Util::Bint(1000000007) * Util::Bint(1000000007));
+	std::cout << v.size() << " " << v[0] << " " << v[4999] << std::endl;
+	sjtu::vector<int> w(sjtu::parallel, 5000000, 3);
+	sjtu::fill(small, w, 11);
+	std::cout << w.size() << " " << sjtu::count(w, 11) << std::endl;
+	sjtu::vector<double> h(small, 100000, 0.5);
+	sjtu::fill(small, h, 2);
+	std::cout << sjtu::count(h, 2) << std::endl;
+}
+
+void TestTransform()
+{
+	std::cout << "Testing parallel transform..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 100000; ++i) {
+		v.push_back(i);
+	}
+	sjtu::vector<std::string> s = sjtu::transform(small, v, [](int x) { return std::to_string(x % 977); });
+	sjtu::vector<double> d = sjtu::transform(sjtu::parallel, v, [](const int &x) { return x * 0.5; });
+	std::cout << s.size() << " " << s[99999] << " " << d[99999] << std::endl;
+	sjtu::vector<Util::Bint> sq = sjtu::vector<Util::Bint>::generate(small, 3000, [](size_t i) {
+		return Util::Bint(int(i)) * Util::Bint(int(i));
+	});
+	std::cout << sq.size() << " " << sq[2999] << std::endl;
+}
+
+void TestException()
+{
+	std::cout << "Testing exceptions in parallel construction..." << std::endl;
+	try {
+		sjtu::vector<std::string> s = sjtu::vector<std::string>::generate(small, 10000, [](size_t i) {
+			if (i == 7777) throw std::string("stop");
+			return std::string(100, char('a' + i % 26));
+		});
+		std::cout << s.size() << std::endl;
+	} catch (const std::string &e) {
+		std::cout << "exception thrown: " << e << std::endl;
+	}
+	try {
+		sjtu::vector<Util::Bint> b = sjtu::vector<Util::Bint>::generate(small, 10000, [](size_t i) {
+			if (i % 2500 == 1234) throw std::string("every chunk");
+			return Util::Bint(int(i)) * Util::Bint(1000000000);
+		});
+		std::cout << b.size() << std::endl;
+	} catch (const std::string &e) {
+		std::cout << "exception thrown: " << e << std::endl;
+	}
+}
+
+int main()
+{
+	TestCopy();
+	TestFill();
+	TestTransform();
+	TestException();
+	return 0;
+}
@@ -0,0 +1,119 @@
+#include "stable_vector.hpp"
+
+#include "class-integer.hpp"
+#include "class-bint.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <new>
+#include <string>
+
+void TestStableAddress()
+{
+	std::cout << "Testing address stability..." << std::endl;
+	sjtu::stable_vector<long long> v;
+	v.push_back(-1);
+	const long long *first = &v[0];
+	sjtu::vector<const long long *> addr;
+	for (long long i = 0; i < 100000; ++i) {
+		addr.push_back(&v.emplace_back(i * i));
+	}
+	bool stable = (first == &v[0]);
+	for (size_t i = 0; i < addr.size(); ++i) {
+		stable = stable && addr[i] == &v[i + 1] && *addr[i] == (long long)i * (long long)i;
+	}
+	std::cout << stable << " " << v.size() << " " << v.back() << std::endl;
+	for (int i = 0; i < 50000; ++i) {
+		v.pop_back();
+	}
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << (v.capacity() >= v.size()) << " " << (first == &v[0]) << std::endl;
+}
+
+void TestStableInterface()
+{
+	std::cout << "Testing stable_vector interface..." << std::endl;
+	sjtu::stable_vector<std::string, 4> v;
+	for (int i = 0; i < 30; ++i) {
+		v.push_back(std::to_string((i * 17) % 30));
+	}
+	sjtu::stable_vector<std::string, 4> copy(v);
+	std::sort(copy.begin(), copy.end());
+	for (sjtu::stable_vector<std::string, 4>::const_iterator it = copy.cbegin(); it != copy.cend(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	std::cout << v.front() << " " << v.back() << " " << v.at(3) << " " << (copy.end() - copy.begin()) << std::endl;
+	try {
+		v.at(30);
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	sjtu::stable_vector<std::string, 4> moved(std::move(copy));
+	const std::string *p = &moved[7];
+	copy = std::move(moved);
+	std::cout << copy.size() << " " << moved.size() << " " << (p == &copy[7]) << std::endl;
+	sjtu::stable_vector<Integer> vInt;
+	for (int i = 0; i < 1000; ++i) {
+		vInt.push_back(Integer(i));
+	}
+	vInt.clear();
+	std::cout << vInt.size() << " " << vInt.empty() << std::endl;
+	sjtu::stable_vector<Util::Bint> vBint;
+	for (int i = 1; i <= 10; ++i) {
+		vBint.emplace_back(Util::Bint(i) * i * i);
+	}
+	vBint = sjtu::stable_vector<Util::Bint>(vBint);
+	for (size_t i = 0; i < vBint.size(); ++i) {
+		std::cout << vBint[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+// a memory resource that counts what it hands out.
+struct counting_resource {
+	size_t calls = 0, live = 0;
+
+	void *allocate(size_t bytes, size_t) {
+		++calls;
+		live += bytes;
+		return ::operator new(bytes);
+	}
+
+	void deallocate(void *p, size_t bytes, size_t) {
+		live -= bytes;
+		::operator delete(p);
+	}
+};
+
+void TestTableAndIterators()
+{
+	std::cout << "Testing the chunk table..." << std::endl;
+	counting_resource r;
+	{
+		typedef sjtu::stable_vector<int, 8, sjtu::resource_allocator<int, counting_resource>> counted;
+		counted v{sjtu::resource_allocator<int, counting_resource>(r)};
+		for (int i = 0; i < 100; ++i) {
+			v.push_back(i);
+		}
+		// 13 chunks, and the table grows through the same resource.
+		std::cout << v.capacity() / 8 << " " << (r.calls > 13) << std::endl;
+		counted::iterator it = v.begin() + 42;
+		counted::const_iterator end = v.cend();
+		counted w(std::move(v));
+		std::cout << *it << " " << (end == w.cend()) << " " << (end - it) << std::endl;
+		counted u{sjtu::resource_allocator<int, counting_resource>(r)};
+		u.push_back(-1);
+		u.swap(w);
+		std::cout << *it << " " << it[57] << " " << u.size() << " " << w.size() << std::endl;
+	}
+	std::cout << r.live << std::endl;
+}
+
+int main()
+{
+	TestStableAddress();
+	TestStableInterface();
+	TestTableAndIterators();
+	return 0;
+}
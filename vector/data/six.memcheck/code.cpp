@@ -0,0 +1,110 @@
+#include "vector.hpp"
+#include "allocator.hpp"
+
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <new>
+#include <string>
+
+template<typename T>
+using arena_vector = sjtu::vector<T, sjtu::default_growth, 0, sjtu::arena_allocator<T>>;
+
+template<typename T>
+using pool_vector = sjtu::vector<T, sjtu::default_growth, 0, sjtu::pool_allocator<T>>;
+
+void TestArena()
+{
+	std::cout << "Testing arena allocator..." << std::endl;
+	sjtu::arena a(4096);
+	for (int round = 0; round < 3; ++round) {
+		long long total = 0;
+		{
+			arena_vector<arena_vector<int>> rows{sjtu::arena_allocator<arena_vector<int>>(a)};
+			for (int i = 0; i < 200; ++i) {
+				arena_vector<int> &row = rows.emplace_back(sjtu::arena_allocator<int>(a));
+				for (int j = 0; j <= i; ++j) {
+					row.push_back(i * j + round);
+				}
+			}
+			arena_vector<arena_vector<int>> copy(rows);
+			for (size_t i = 0; i < copy.size(); ++i) {
+				for (size_t j = 0; j < copy[i].size(); ++j) {
+					total += copy[i][j];
+				}
+			}
+		}
+		a.reset();
+		std::cout << total << std::endl;
+	}
+	arena_vector<std::string> s{sjtu::arena_allocator<std::string>(a)};
+	for (int i = 0; i < 100; ++i) {
+		s.push_back(std::string(i % 7 + 20, char('a' + i % 26)));
+	}
+	s.erase(s.begin(), s.begin() + 90);
+	std::cout << s.size() << " " << s.front() << " " << (s.get_allocator().resource() == &a) << std::endl;
+}
+
+void TestPool()
+{
+	std::cout << "Testing pool allocator..." << std::endl;
+	sjtu::pool p;
+	pool_vector<Util::Bint> big{sjtu::pool_allocator<Util::Bint>(p)};
+	for (int i = 1; i <= 30; ++i) {
+		big.push_back(Util::Bint(i) * Util::Bint(i));
+	}
+	pool_vector<Util::Bint> other{sjtu::pool_allocator<Util::Bint>(p)};
+	other = big;
+	big.clear();
+	big.shrink_to_fit();
+	for (int round = 0; round < 1000; ++round) {
+		pool_vector<long long> tiny{sjtu::pool_allocator<long long>(p)};
+		for (int i = 0; i < round % 50; ++i) {
+			tiny.push_back(i);
+		}
+		if (round == 999) {
+			std::cout << tiny.size() << " " << tiny.back() << std::endl;
+		}
+	}
+	std::cout << other.size() << " " << other[29] << std::endl;
+	pool_vector<Util::Bint> moved(std::move(other));
+	moved.swap(big);
+	std::cout << moved.size() << " " << big.size() << " " << big.front() << std::endl;
+}
+
+// a size whose byte count overflows is refused instead of allocating a tiny buffer.
+void TestOverflow()
+{
+	std::cout << "Testing huge requests..." << std::endl;
+	const size_t huge = (size_t(1) << 61) + 1;
+	sjtu::vector<long long> v;
+	for (int i = 0; i < 3; ++i) {
+		v.push_back(7);
+	}
+	try {
+		v.reserve(huge);
+	} catch (std::bad_array_new_length &) {
+		std::cout << "refused " << v.size() << " " << v[2] << std::endl;
+	}
+	sjtu::arena a;
+	arena_vector<long long> w{sjtu::arena_allocator<long long>(a)};
+	w.push_back(5);
+	try {
+		w.reserve(huge);
+	} catch (std::bad_array_new_length &) {
+		std::cout << "refused " << w.size() << " " << w[0] << std::endl;
+	}
+	try {
+		a.allocate(size_t(-1) - 4, 8);
+	} catch (std::bad_array_new_length &) {
+		std::cout << "refused" << std::endl;
+	}
+}
+
+int main()
+{
+	TestArena();
+	TestPool();
+	TestOverflow();
+	return 0;
+}
@@ -0,0 +1,69 @@
+#include "vector.hpp"
+#include "cow_vector.hpp"
+#include "stable_vector.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+// one element per cache line, more than operator new aligns by default.
+struct alignas(64) Line {
+	long long value;
+	char pad[8];
+
+	explicit Line(long long value = 0) : value(value), pad() {}
+};
+
+template<class V>
+bool Aligned(const V &v)
+{
+	bool ok = true;
+	for (size_t i = 0; i < v.size(); ++i) {
+		ok = ok && reinterpret_cast<std::uintptr_t>(&v[i]) % alignof(Line) == 0;
+	}
+	return ok;
+}
+
+template<class V>
+long long Sum(const V &v)
+{
+	long long s = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		s += v[i].value;
+	}
+	return s;
+}
+
+void TestOverAligned()
+{
+	std::cout << "Testing over-aligned elements..." << std::endl;
+	sjtu::vector<Line> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(Line(i));
+		if (i % 3 == 0) v.push_front(Line(-i));
+	}
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << Sum(v) << " " << Aligned(v) << std::endl;
+	sjtu::small_vector<Line, 2> s;
+	for (int i = 0; i < 100; ++i) {
+		s.emplace_back(i);
+	}
+	std::cout << s.size() << " " << Sum(s) << " " << Aligned(s) << std::endl;
+	sjtu::stable_vector<Line> st;
+	for (int i = 0; i < 500; ++i) {
+		st.emplace_back(i * 2);
+	}
+	std::cout << st.size() << " " << Sum(st) << " " << Aligned(st) << std::endl;
+	sjtu::cow_vector<Line> c;
+	for (int i = 0; i < 300; ++i) {
+		c.push_back(Line(i));
+	}
+	sjtu::cow_vector<Line> d(c);
+	d.push_back(Line(1000));
+	std::cout << c.size() << " " << d.size() << " " << Sum(d) << " " << Aligned(c) << Aligned(d) << std::endl;
+}
+
+int main()
+{
+	TestOverAligned();
+	return 0;
+}
@@ -0,0 +1,97 @@
+#include "cow_vector.hpp"
+
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <string>
+
+void TestSharing()
+{
+	std::cout << "Testing shared copies..." << std::endl;
+	sjtu::cow_vector<long long> v;
+	std::cout << v.use_count() << " " << v.size() << std::endl;
+	for (long long i = 0; i < 1000000; ++i) {
+		v.push_back(i * 3);
+	}
+	sjtu::cow_vector<long long> copies[100];
+	for (int i = 0; i < 100; ++i) {
+		copies[i] = v;
+	}
+	const sjtu::cow_vector<long long> &cv = v;
+	std::cout << v.use_count() << " " << (copies[50].view().data() == cv.data()) << " " << copies[99].at(999999) << std::endl;
+	copies[7].push_back(-1);
+	copies[8].pop_back();
+	copies[9].erase(0);
+	copies[10].insert(1, 5);
+	std::cout << v.use_count() << " " << cv.size() << " " << copies[7].size() << " " << copies[8].size() << " "
+			  << copies[9].view()[0] << " " << copies[10].view()[1] << " " << cv.back() << std::endl;
+	sjtu::cow_vector<long long> moved(std::move(copies[0]));
+	std::cout << v.use_count() << " " << copies[0].use_count() << " " << (moved == v) << " " << (copies[7] != v) << std::endl;
+	for (int i = 0; i < 100; ++i) {
+		copies[i].clear();
+	}
+	std::cout << v.use_count() << " " << copies[7].empty() << std::endl;
+}
+
+void TestLeakedReferences()
+{
+	std::cout << "Testing mutable references..." << std::endl;
+	sjtu::cow_vector<std::string> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	sjtu::cow_vector<std::string> a(v);
+	std::string &ref = v[3];
+	ref = "three";
+	sjtu::cow_vector<std::string> b(v);
+	ref = "THREE";
+	std::cout << a.view()[3] << " " << b.view()[3] << " " << v.view()[3] << " " << v.use_count() << " " << b.use_count() << std::endl;
+	for (sjtu::cow_vector<std::string>::iterator it = v.begin(); it != v.end(); ++it) {
+		*it += "!";
+	}
+	const sjtu::cow_vector<std::string> &cv = v;
+	for (sjtu::cow_vector<std::string>::const_iterator it = cv.cbegin(); it != cv.cend(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	v.insert(v.begin() + 1, "one");
+	v.erase(v.end() - 1);
+	v.clear();
+	v.push_back("x");
+	sjtu::cow_vector<std::string> c(v);
+	std::cout << v.size() << " " << c.use_count() << " " << a.size() << std::endl;
+}
+
+void TestFromVector()
+{
+	std::cout << "Testing construction from vector..." << std::endl;
+	sjtu::vector<Util::Bint> items;
+	for (int i = 0; i < 20; ++i) {
+		items.push_back(Util::Bint(i) * Util::Bint(1000000000) * Util::Bint(1000000000));
+	}
+	sjtu::cow_vector<Util::Bint> v(std::move(items));
+	sjtu::cow_vector<Util::Bint> w = v;
+	w.push_front(Util::Bint(1));
+	w.pop_back();
+	std::cout << items.size() << " " << v.size() << " " << w.size() << " " << w.front() << " " << w.back() << " " << v.back() << std::endl;
+	try {
+		const sjtu::cow_vector<Util::Bint> &cw = w;
+		std::cout << cw[20] << std::endl;
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	try {
+		sjtu::cow_vector<int> e;
+		e.pop_front();
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+}
+
+int main()
+{
+	TestSharing();
+	TestLeakedReferences();
+	TestFromVector();
+	return 0;
+}
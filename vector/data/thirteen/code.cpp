@@ -0,0 +1,160 @@
+#include "concurrent_vector.hpp"
+
+#include "class-bint.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+
+const int threads = 8;
+// makes the aligned operator new, which allocates the segments, fail while set.
+std::atomic<bool> failAligned(false);
+
+void *operator new(std::size_t n, std::align_val_t a)
+{
+	if (failAligned.load()) throw std::bad_alloc();
+	size_t align = size_t(a);
+	void *p = std::aligned_alloc(align, (n + align - 1) / align * align);
+	if (p == nullptr) throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+	std::free(p);
+}
+
+const int perThread = 100000;
+
+void TestPush()
+{
+	std::cout << "Testing concurrent push_back..." << std::endl;
+	sjtu::concurrent_vector<long long> v;
+	std::atomic<bool> done(false);
+	std::atomic<long long> badReads(0);
+	std::thread reader([&] {
+		while (!done.load()) {
+			size_t n = v.size();
+			for (size_t i = n > 1000 ? n - 1000 : 0; i < n; ++i) {
+				long long x = v[i];
+				if (x % 1000000 >= perThread || x / 1000000 >= threads) ++badReads;
+			}
+		}
+	});
+	std::thread workers[threads];
+	for (int t = 0; t < threads; ++t) {
+		workers[t] = std::thread([&v, t] {
+			for (int j = 0; j < perThread; ++j) {
+				v.push_back(t * 1000000LL + j);
+			}
+		});
+	}
+	for (int t = 0; t < threads; ++t) {
+		workers[t].join();
+	}
+	done = true;
+	reader.join();
+	int seen[threads] = {0};
+	bool ordered = true;
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		int t = int(v[i] / 1000000);
+		ordered = ordered && v[i] % 1000000 == seen[t];
+		++seen[t];
+		sum += v[i];
+	}
+	std::cout << v.size() << " " << ordered << " " << sum << " " << badReads.load() << std::endl;
+}
+
+void TestStableReferences()
+{
+	std::cout << "Testing stable references..." << std::endl;
+	sjtu::concurrent_vector<std::string> v;
+	size_t first = v.emplace_back(50, 'x');
+	const std::string *p = &v[first];
+	std::thread workers[4];
+	for (int t = 0; t < 4; ++t) {
+		workers[t] = std::thread([&v, t] {
+			for (int j = 0; j < 20000; ++j) {
+				v.emplace_back(std::to_string(t) + ":" + std::to_string(j));
+			}
+		});
+	}
+	for (int t = 0; t < 4; ++t) {
+		workers[t].join();
+	}
+	size_t chars = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		chars += v.at(i).size();
+	}
+	std::cout << v.size() << " " << (p == &v[0]) << " " << *p << " " << chars << std::endl;
+	std::cout << (v.capacity() >= v.size()) << std::endl;
+	try {
+		v.at(80001);
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+}
+
+struct Fragile {
+	int x;
+
+	explicit Fragile(int x) : x(x) {
+		if (x < 0) throw std::string("negative");
+	}
+
+	Fragile(Fragile &&other) noexcept : x(other.x) {}
+};
+
+void TestExceptions()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	sjtu::concurrent_vector<Fragile, 4> v;
+	v.reserve(100);
+	std::cout << v.capacity() << std::endl;
+	for (int i = 0; i < 20; ++i) {
+		try {
+			v.emplace_back(i % 3 == 0 ? -i : i);
+		} catch (const std::string &e) {
+			std::cout << e << " ";
+		}
+	}
+	std::cout << std::endl << v.size() << " " << v[0].x << " " << v[12].x << std::endl;
+	v.clear();
+	std::cout << v.size() << " " << v.empty() << std::endl;
+	// a segment that cannot be allocated claims no index.
+	sjtu::concurrent_vector<int, 4> w;
+	for (int i = 0; i < 4; ++i) {
+		w.push_back(i);
+	}
+	failAligned = true;
+	try {
+		w.push_back(4);
+	} catch (std::bad_alloc &) {
+		std::cout << "bad_alloc ";
+	}
+	failAligned = false;
+	size_t at = w.push_back(5);
+	std::cout << at << " " << w.size() << " " << w[4] << std::endl;
+	sjtu::concurrent_vector<Util::Bint> b;
+	for (int i = 0; i < 100; ++i) {
+		b.push_back(Util::Bint(i) * Util::Bint(i));
+	}
+	std::cout << b.size() << " " << b[99] << std::endl;
+}
+
+int main()
+{
+	TestPush();
+	TestStableReferences();
+	TestExceptions();
+	return 0;
+}
@@ -0,0 +1,182 @@
+#include "vector.hpp"
+
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+namespace sjtu {
+	template<>
+	struct serializer<Util::Bint> {
+		static void save(std::ostream &os, const Util::Bint &x) {
+			std::ostringstream text;
+			text << x;
+			serializer<std::string>::save(os, text.str());
+		}
+
+		static Util::Bint load(std::istream &is) {
+			return Util::Bint(serializer<std::string>::load(is));
+		}
+	};
+}
+
+struct Point {
+	int x, y;
+	double w;
+};
+
+// a stream over s that cannot seek, like a pipe.
+struct pipe_buf : std::streambuf {
+	std::string data;
+
+	explicit pipe_buf(const std::string &s) : data(s) {
+		setg(&data[0], &data[0], &data[0] + data.size());
+	}
+};
+
+// bytes with the element count in their header replaced by n.
+std::string WithCount(std::string bytes, std::uint64_t n)
+{
+	std::memcpy(&bytes[16], &n, sizeof(n));
+	return bytes;
+}
+
+void TestRaw()
+{
+	std::cout << "Testing trivially copyable elements..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 100000; ++i) {
+		v.push_back(i * 7 - 3);
+	}
+	std::stringstream ss;
+	v.save(ss);
+	std::cout << ss.str().size() << std::endl;
+	sjtu::vector<int> w;
+	w.push_back(1);
+	w.load(ss);
+	std::cout << w.size() << " " << (w == v) << " " << w[99999] << std::endl;
+	sjtu::small_vector<Point, 4> p;
+	for (int i = 0; i < 3; ++i) {
+		p.push_back(Point{i, -i, i * 0.5});
+	}
+	std::stringstream sp;
+	p.save(sp);
+	sjtu::small_vector<Point, 4> q;
+	q.load(sp);
+	std::cout << q.size() << " " << q[2].x << " " << q[2].y << " " << q[2].w << " " << q.capacity() << std::endl;
+	sjtu::vector<Point> big;
+	sp.clear();
+	sp.seekg(0);
+	big.load(sp);
+	std::cout << big.size() << " " << big[1].w << std::endl;
+}
+
+void TestHooks()
+{
+	std::cout << "Testing elements with serializers..." << std::endl;
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 1000; ++i) {
+		s.push_back(std::string(i % 10, char('a' + i % 26)));
+	}
+	std::stringstream ss;
+	s.save(ss);
+	sjtu::vector<std::string> t;
+	t.load(ss);
+	std::cout << t.size() << " " << (t == s) << " " << t[999] << std::endl;
+	sjtu::vector<Util::Bint> b;
+	b.push_back(Util::Bint(1));
+	for (int i = 1; i < 30; ++i) {
+		b.push_back(b.back() * Util::Bint(1000003));
+	}
+	std::stringstream sb;
+	b.save(sb);
+	sjtu::vector<Util::Bint> c;
+	c.load(sb);
+	std::cout << c.size() << " " << (c == b) << " " << c[29] << std::endl;
+}
+
+void TestErrors()
+{
+	std::cout << "Testing bad snapshots..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(i);
+	}
+	std::stringstream ss;
+	v.save(ss);
+	std::string bytes = ss.str();
+	sjtu::vector<long long> other;
+	std::stringstream s1(bytes);
+	try {
+		other.load(s1);
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	sjtu::vector<int> w;
+	w.push_back(42);
+	std::stringstream s2(bytes.substr(0, bytes.size() - 1));
+	try {
+		w.load(s2);
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	std::stringstream s3("definitely not a snapshot");
+	try {
+		w.load(s3);
+	} catch (...) {
+		std::cout << "exception thrown" << std::endl;
+	}
+	std::cout << w.size() << " " << w[0] << std::endl;
+	// counts that do not fit in memory or in the stream.
+	sjtu::vector<long long> one;
+	one.push_back(5);
+	std::stringstream so;
+	one.save(so);
+	std::string huge = WithCount(so.str(), (std::uint64_t(1) << 61) + 1);
+	std::stringstream s4(huge);
+	try {
+		other.load(s4);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "runtime_error thrown" << std::endl;
+	}
+	pipe_buf pb(huge);
+	std::istream s5(&pb);
+	try {
+		other.load(s5);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "runtime_error thrown" << std::endl;
+	}
+	pipe_buf pb2(WithCount(bytes, 1000000));
+	std::istream s6(&pb2);
+	try {
+		w.load(s6);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "runtime_error thrown" << std::endl;
+	}
+	sjtu::vector<std::string> words;
+	words.push_back("x");
+	std::stringstream sw;
+	words.save(sw);
+	std::stringstream s7(WithCount(sw.str(), ~std::uint64_t(0)));
+	try {
+		words.load(s7);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "runtime_error thrown" << std::endl;
+	}
+	pipe_buf pb3(so.str());
+	std::istream s8(&pb3);
+	other.load(s8);
+	std::cout << w.size() << " " << words.size() << " " << words[0] << " " << other.size() << " " << other[0] << std::endl;
+}
+
+int main()
+{
+	TestRaw();
+	TestHooks();
+	TestErrors();
+	return 0;
+}
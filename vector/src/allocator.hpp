@@ -0,0 +1,254 @@
+#ifndef SJTU_ALLOCATOR_HPP
+#define SJTU_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace sjtu {
+
+/**
+ * allocators hand raw, uninitialized memory to containers.
+ * an allocator for T only needs to be copyable and provide
+ *
+ *   T *allocate(size_t n);              // room for n objects, throws on failure
+ *   void deallocate(T *p, size_t n);    // p and n exactly as returned / requested
+ *
+ * copies of an allocator must be able to free each other's memory.
+ */
+template<typename T>
+class allocator {
+public:
+    allocator() = default;
+
+    template<typename U>
+    allocator(const allocator<U> &) {}
+
+    /**
+     * throw std::bad_array_new_length if n * sizeof(T) does not fit in size_t,
+     * as std::allocator does.
+     */
+    T *allocate(size_t n) {
+        if (n > size_t(-1) / sizeof(T)) throw std::bad_array_new_length();
+        if constexpr (overAligned) return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, size_t) {
+        if constexpr (overAligned) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+private:
+    // plain operator new only guarantees the default new alignment.
+    static constexpr bool overAligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+};
+
+/**
+ * a monotonic arena: allocation bumps a pointer through large blocks and
+ * deallocate does nothing. All memory is returned at once by reset() or
+ * the destructor, so the objects living in it must have been destroyed
+ * (or need no destruction) by then.
+ */
+class arena {
+public:
+    explicit arena(size_t blockSize = 64 * 1024) : head(nullptr), cur(nullptr), last(nullptr), blockSize(blockSize) {}
+
+    arena(const arena &) = delete;
+
+    arena &operator=(const arena &) = delete;
+
+    ~arena() {
+        reset();
+    }
+
+    void *allocate(size_t bytes, size_t align) {
+        // a block must fit the header, the padding and the bytes.
+        if (bytes > size_t(-1) - align - sizeof(block)) throw std::bad_array_new_length();
+        size_t pad = (align - reinterpret_cast<size_t>(cur) % align) % align;
+        if (cur == nullptr || pad + bytes > static_cast<size_t>(last - cur)) {
+            newBlock(bytes + align);
+            pad = (align - reinterpret_cast<size_t>(cur) % align) % align;
+        }
+        char *p = cur + pad;
+        cur = p + bytes;
+        return p;
+    }
+
+    void deallocate(void *, size_t, size_t) {}
+
+    /**
+     * frees every block at once.
+     */
+    void reset() {
+        while (head != nullptr) {
+            block *next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+        cur = last = nullptr;
+    }
+
+private:
+    struct block {
+        block *next;
+    };
+
+    block *head;
+    char *cur, *last;
+    size_t blockSize;
+
+    void newBlock(size_t atLeast) {
+        size_t bytes = atLeast > blockSize ? atLeast : blockSize;
+        block *b = static_cast<block *>(::operator new(sizeof(block) + bytes));
+        b->next = head;
+        head = b;
+        cur = reinterpret_cast<char *>(b + 1);
+        last = cur + bytes;
+    }
+};
+
+/**
+ * a pool of power-of-two size classes from 16 bytes to 4 KB. Freed blocks go
+ * onto the free list of their class and are handed out again, so containers
+ * that keep growing and shrinking stop calling operator new once warmed up.
+ * larger or over-aligned requests go straight to operator new.
+ * one pool can serve any number of containers; it is not thread safe.
+ */
+class pool {
+public:
+    pool() : slabs(nullptr) {
+        for (size_t i = 0; i < classCount; ++i) freeList[i] = nullptr;
+    }
+
+    pool(const pool &) = delete;
+
+    pool &operator=(const pool &) = delete;
+
+    ~pool() {
+        while (slabs != nullptr) {
+            node *next = slabs->next;
+            ::operator delete(slabs);
+            slabs = next;
+        }
+    }
+
+    void *allocate(size_t bytes, size_t align) {
+        size_t c = sizeClass(bytes);
+        if (align > minBlock) return ::operator new(bytes, std::align_val_t(align));
+        if (c == classCount) return ::operator new(bytes);
+        if (freeList[c] == nullptr) refill(c);
+        node *p = freeList[c];
+        freeList[c] = p->next;
+        return p;
+    }
+
+    void deallocate(void *p, size_t bytes, size_t align) {
+        size_t c = sizeClass(bytes);
+        if (align > minBlock) {
+            ::operator delete(p, std::align_val_t(align));
+            return;
+        }
+        if (c == classCount) {
+            ::operator delete(p);
+            return;
+        }
+        node *n = static_cast<node *>(p);
+        n->next = freeList[c];
+        freeList[c] = n;
+    }
+
+private:
+    struct node {
+        node *next;
+    };
+
+    static const size_t minBlock = 16;
+    static const size_t classCount = 9;   // 16, 32, ..., 4096
+    static const size_t slabSize = 64 * 1024;
+
+    node *freeList[classCount];
+    node *slabs;
+
+    static size_t sizeClass(size_t bytes) {
+        size_t c = 0, size = minBlock;
+        while (c < classCount && size < bytes) {
+            size *= 2;
+            ++c;
+        }
+        return c;
+    }
+
+    // carves one slab into blocks of class c.
+    void refill(size_t c) {
+        size_t size = minBlock << c;
+        node *slab = static_cast<node *>(::operator new(slabSize));
+        slab->next = slabs;
+        slabs = slab;
+        char *first = reinterpret_cast<char *>(slab) + minBlock;
+        char *end = reinterpret_cast<char *>(slab) + slabSize;
+        for (char *p = first; p + size <= end; p += size) {
+            node *n = reinterpret_cast<node *>(p);
+            n->next = freeList[c];
+            freeList[c] = n;
+        }
+    }
+};
+
+/**
+ * an allocator that forwards to a shared memory resource such as arena or
+ * pool. The resource must outlive every container that uses it.
+ */
+template<typename T, class Resource>
+class resource_allocator {
+public:
+    explicit resource_allocator(Resource &r) : res(&r) {}
+
+    template<typename U>
+    resource_allocator(const resource_allocator<U, Resource> &other) : res(other.resource()) {}
+
+    /**
+     * throw std::bad_array_new_length if n * sizeof(T) does not fit in size_t.
+     */
+    T *allocate(size_t n) {
+        if (n > size_t(-1) / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T *>(res->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p, size_t n) {
+        res->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    Resource *resource() const {
+        return res;
+    }
+
+private:
+    Resource *res;
+};
+
+template<typename T>
+using arena_allocator = resource_allocator<T, arena>;
+
+template<typename T>
+using pool_allocator = resource_allocator<T, pool>;
+
+/**
+ * the same kind of allocator for elements of type U, for containers that
+ * store something other than their element type (vector<bool> stores words).
+ * works for any allocator template whose first argument is the element type;
+ * the rebound allocator is built from the original by its converting constructor.
+ */
+template<class Alloc, typename U>
+struct rebind_allocator;
+
+template<template<typename, typename...> class Alloc, typename T, typename... Rest, typename U>
+struct rebind_allocator<Alloc<T, Rest...>, U> {
+    using type = Alloc<U, Rest...>;
+};
+
+}
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef SJTU_CONCURRENT_VECTOR_HPP
+#define SJTU_CONCURRENT_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+/**
+ * an append-only vector that many threads may push_back / emplace_back to
+ * at once without a lock.
+ *
+ * a push claims its index with a compare-and-swap on a counter, once the
+ * segment for that index exists, so pushes never wait for each other and a
+ * failed allocation claims nothing. Elements live in segments whose sizes double (Base, 2 Base,
+ * 4 Base, ...) and are never moved or freed before the vector dies, so a
+ * reference stays valid while other threads keep appending.
+ *
+ * size() counts the published prefix: every index below it is fully
+ * constructed and may be read from any thread, concurrently with further
+ * pushes. A push is published once it and every push with a smaller index
+ * have finished; whichever thread finishes last advances size() for all.
+ *
+ * clear() and destruction must not race with anything else.
+ */
+    template<typename T, size_t Base = 32>
+    class concurrent_vector {
+        static_assert(Base != 0 && (Base & (Base - 1)) == 0, "the first segment size must be a power of two");
+
+    public:
+        concurrent_vector() : reserved(0), published(0) {
+            for (size_t k = 0; k < maxSegments; ++k) segments[k].store(nullptr, std::memory_order_relaxed);
+        }
+
+        concurrent_vector(const concurrent_vector &) = delete;
+
+        concurrent_vector &operator=(const concurrent_vector &) = delete;
+
+        ~concurrent_vector() {
+            clear();
+            for (size_t k = 0; k < maxSegments; ++k) {
+                char *seg = segments[k].load(std::memory_order_relaxed);
+                if (seg != nullptr) freeSegment(seg);
+            }
+        }
+
+        /**
+         * appends a copy of value; returns its index.
+         */
+        size_t push_back(const T &value) {
+            return emplace_back(value);
+        }
+
+        size_t push_back(T &&value) {
+            return emplace_back(std::move(value));
+        }
+
+        /**
+         * constructs an element at the end; returns its index.
+         * if T's constructor may throw, the element is built aside first and
+         * then moved into its slot; neither that nor a failed segment
+         * allocation claims an index.
+         */
+        template<typename... Args>
+        size_t emplace_back(Args &&...args) {
+            if constexpr (std::is_nothrow_constructible<T, Args &&...>::value) {
+                size_t i = claim();
+                new(slot(i)) T(std::forward<Args>(args)...);
+                publish(i);
+                return i;
+            } else {
+                static_assert(std::is_nothrow_move_constructible<T>::value,
+                              "concurrent_vector needs a constructor or a move constructor that cannot throw");
+                T tmp(std::forward<Args>(args)...);
+                size_t i = claim();
+                new(slot(i)) T(std::move(tmp));
+                publish(i);
+                return i;
+            }
+        }
+
+        /**
+         * the element at pos, which must be below a size() seen by this thread
+         * (or an index returned to it by a push).
+         */
+        T &operator[](const size_t &pos) {
+            return *slot(pos);
+        }
+
+        const T &operator[](const size_t &pos) const {
+            return *const_cast<concurrent_vector *>(this)->slot(pos);
+        }
+
+        /**
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        T &at(const size_t &pos) {
+            if (pos >= size()) throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        const T &at(const size_t &pos) const {
+            if (pos >= size()) throw index_out_of_bound();
+            return (*this)[pos];
+        }
+
+        /**
+         * the number of published elements.
+         */
+        size_t size() const {
+            return published.load(std::memory_order_acquire);
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * the number of slots in the allocated segments.
+         */
+        size_t capacity() const {
+            size_t n = 0;
+            for (size_t k = 0; k < maxSegments && segments[k].load(std::memory_order_acquire) != nullptr; ++k) {
+                n += segmentSize(k);
+            }
+            return n;
+        }
+
+        /**
+         * allocates the segments needed for n elements up front; safe to call
+         * while other threads push.
+         */
+        void reserve(size_t n) {
+            for (size_t k = 0; k < maxSegments && firstIndex(k) < n; ++k) segment(k);
+        }
+
+        /**
+         * destroys every element and keeps the segments. Must not race with other calls.
+         */
+        void clear() {
+            size_t n = reserved.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < n; ++i) {
+                if (ready(i).load(std::memory_order_relaxed)) {
+                    slot(i)->~T();
+                    ready(i).store(false, std::memory_order_relaxed);
+                }
+            }
+            reserved.store(0, std::memory_order_relaxed);
+            published.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t baseShift = __builtin_ctzll(Base);
+        static constexpr size_t maxSegments = 64 - baseShift;
+
+        // segment k holds T slots followed by one ready flag per slot.
+        std::atomic<char *> segments[maxSegments];
+        std::atomic<size_t> reserved;
+        std::atomic<size_t> published;
+
+        static size_t segmentSize(size_t k) {
+            return Base << k;
+        }
+
+        // the index of the first element in segment k.
+        static size_t firstIndex(size_t k) {
+            return (Base << k) - Base;
+        }
+
+        static size_t segmentOf(size_t i) {
+            return 63 - __builtin_clzll((unsigned long long) (i / Base + 1));
+        }
+
+        static size_t flagOffset(size_t k) {
+            return segmentSize(k) * sizeof(T);
+        }
+
+        static char *allocSegment(size_t k) {
+            char *seg = static_cast<char *>(::operator new(flagOffset(k) + segmentSize(k) * sizeof(std::atomic<bool>),
+                                                           std::align_val_t(alignof(T))));
+            auto *flags = reinterpret_cast<std::atomic<bool> *>(seg + flagOffset(k));
+            for (size_t j = 0; j < segmentSize(k); ++j) new(flags + j) std::atomic<bool>(false);
+            return seg;
+        }
+
+        static void freeSegment(char *seg) {
+            ::operator delete(seg, std::align_val_t(alignof(T)));
+        }
+
+        // the segment k, allocating it if no thread has yet; racing threads agree on one.
+        char *segment(size_t k) {
+            char *seg = segments[k].load(std::memory_order_acquire);
+            if (seg != nullptr) return seg;
+            char *fresh = allocSegment(k);
+            if (segments[k].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel)) return fresh;
+            freeSegment(fresh);
+            return seg;
+        }
+
+        T *slot(size_t i) {
+            size_t k = segmentOf(i);
+            return reinterpret_cast<T *>(segment(k)) + (i - firstIndex(k));
+        }
+
+        std::atomic<bool> &ready(size_t i) {
+            size_t k = segmentOf(i);
+            return reinterpret_cast<std::atomic<bool> *>(segment(k) + flagOffset(k))[i - firstIndex(k)];
+        }
+
+        /**
+         * claims the next index. Its segment is allocated before the claim, so
+         * if that throws no index is lost; a failed compare-and-swap retries
+         * with the index another thread left next.
+         */
+        size_t claim() {
+            size_t i = reserved.load(std::memory_order_relaxed);
+            do {
+                segment(segmentOf(i));
+            } while (!reserved.compare_exchange_weak(i, i + 1, std::memory_order_relaxed));
+            return i;
+        }
+
+        /**
+         * marks slot i as constructed, then advances published over every
+         * constructed slot after it. The flag store and the loads of published
+         * are sequentially consistent, so of two threads finishing neighbouring
+         * slots at least one sees the other's flag and moves past both.
+         */
+        void publish(size_t i) {
+            ready(i).store(true);
+            size_t p = published.load();
+            while (p < reserved.load(std::memory_order_relaxed) && ready(p).load()) {
+                if (published.compare_exchange_weak(p, p + 1)) ++p;
+            }
+        }
+    };
+}
+
+#endif
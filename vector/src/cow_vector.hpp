@@ -0,0 +1,317 @@
+#ifndef SJTU_COW_VECTOR_HPP
+#define SJTU_COW_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace sjtu {
+/**
+ * a copy-on-write vector: copies share one reference-counted buffer, so
+ * copying and assigning are O(1), and the first mutation of a shared copy
+ * clones the elements. Reads never copy.
+ *
+ * handing out a mutable reference, pointer or iterator (non-const at,
+ * operator[], begin/end, data) marks the buffer unshareable, so
+ * a later copy clones it right away and a write through that reference can
+ * never show up in the copy. clear() and assignment make it shareable again.
+ *
+ * the reference count is atomic: copies owned by different threads may be
+ * read, copied and destroyed concurrently, like std::shared_ptr.
+ */
+    template<typename T, class Growth = default_growth, size_t N = 0, class Allocator = allocator<T>>
+    class cow_vector {
+    public:
+        using vector_type = vector<T, Growth, N, Allocator>;
+        using iterator = typename vector_type::iterator;
+        using const_iterator = typename vector_type::const_iterator;
+
+        /**
+         * an empty cow_vector allocates nothing.
+         */
+        cow_vector() : rep(nullptr) {}
+
+        /**
+         * takes over the elements of items.
+         */
+        explicit cow_vector(vector_type items) : rep(new shared(std::move(items))) {}
+
+        /**
+         * shares the buffer of other in O(1), unless other has handed out mutable references.
+         */
+        cow_vector(const cow_vector &other) : rep(other.rep) {
+            if (rep == nullptr) return;
+            if (rep->shareable) {
+                rep->refs.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                rep = new shared(other.rep->items);
+            }
+        }
+
+        cow_vector(cow_vector &&other) noexcept : rep(other.rep) {
+            other.rep = nullptr;
+        }
+
+        ~cow_vector() {
+            drop();
+        }
+
+        cow_vector &operator=(const cow_vector &other) {
+            if (this == &other) return *this;
+            cow_vector tmp(other);
+            swap(tmp);
+            return *this;
+        }
+
+        cow_vector &operator=(cow_vector &&other) noexcept {
+            if (this == &other) return *this;
+            cow_vector tmp(std::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        void swap(cow_vector &other) noexcept {
+            shared *f0 = rep;
+            rep = other.rep;
+            other.rep = f0;
+        }
+
+        /**
+         * the elements, read-only; never copies.
+         */
+        const vector_type &view() const {
+            return rep != nullptr ? rep->items : nothing();
+        }
+
+        /**
+         * the number of cow_vectors sharing this buffer; 0 if nothing is allocated.
+         */
+        size_t use_count() const {
+            return rep != nullptr ? rep->refs.load(std::memory_order_acquire) : 0;
+        }
+
+        /**
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        const T &at(const size_t &pos) const {
+            return view().at(pos);
+        }
+
+        T &at(const size_t &pos) {
+            if (pos >= size()) throw index_out_of_bound();
+            return mutate(true).at(pos);
+        }
+
+        const T &operator[](const size_t &pos) const {
+            return at(pos);
+        }
+
+        T &operator[](const size_t &pos) {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        const T &front() const {
+            return view().front();
+        }
+
+        const T &back() const {
+            return view().back();
+        }
+
+        iterator begin() {
+            return mutate(true).begin();
+        }
+
+        const_iterator begin() const {
+            return view().cbegin();
+        }
+
+        const_iterator cbegin() const {
+            return view().cbegin();
+        }
+
+        iterator end() {
+            return mutate(true).end();
+        }
+
+        const_iterator end() const {
+            return view().cend();
+        }
+
+        const_iterator cend() const {
+            return view().cend();
+        }
+
+        T *data() {
+            return mutate(true).data();
+        }
+
+        const T *data() const {
+            return view().data();
+        }
+
+        bool empty() const {
+            return view().empty();
+        }
+
+        size_t size() const {
+            return view().size();
+        }
+
+        size_t capacity() const {
+            return view().capacity();
+        }
+
+        void reserve(size_t n) {
+            if (n > capacity()) mutate().reserve(n);
+        }
+
+        void shrink_to_fit() {
+            if (capacity() != size()) mutate().shrink_to_fit();
+        }
+
+        /**
+         * a shared buffer is left to the other copies instead of being cleared.
+         */
+        void clear() {
+            if (use_count() > 1) {
+                drop();
+                rep = nullptr;
+                return;
+            }
+            if (rep == nullptr) return;
+            rep->items.clear();
+            rep->shareable = true;
+        }
+
+        /**
+         * inserts value before pos, an iterator from this cow_vector.
+         */
+        iterator insert(iterator pos, const T &value) {
+            return mutate(true).insert(pos, value);
+        }
+
+        iterator insert(iterator pos, T &&value) {
+            return mutate(true).insert(pos, std::move(value));
+        }
+
+        /**
+         * throw index_out_of_bound if ind > size
+         * returns nothing, unlike vector, so the buffer stays shareable.
+         */
+        void insert(const size_t &ind, const T &value) {
+            if (ind > size()) throw index_out_of_bound();
+            vector_type &items = mutate();
+            items.insert(items.begin() + ind, value);
+        }
+
+        iterator erase(iterator pos) {
+            return mutate(true).erase(pos);
+        }
+
+        /**
+         * throw index_out_of_bound if ind >= size
+         * returns nothing, unlike vector, so the buffer stays shareable.
+         */
+        void erase(const size_t &ind) {
+            if (ind >= size()) throw index_out_of_bound();
+            mutate().erase(ind);
+        }
+
+        void push_back(const T &value) {
+            mutate().push_back(value);
+        }
+
+        void push_back(T &&value) {
+            mutate().push_back(std::move(value));
+        }
+
+        template<typename... Args>
+        void emplace_back(Args &&...args) {
+            mutate().emplace_back(std::forward<Args>(args)...);
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back() {
+            if (empty()) throw container_is_empty();
+            mutate().pop_back();
+        }
+
+        void push_front(const T &value) {
+            mutate().push_front(value);
+        }
+
+        void push_front(T &&value) {
+            mutate().push_front(std::move(value));
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_front() {
+            if (empty()) throw container_is_empty();
+            mutate().pop_front();
+        }
+
+    private:
+        struct shared {
+            std::atomic<size_t> refs;
+            bool shareable;
+            vector_type items;
+
+            shared() : refs(1), shareable(true) {}
+
+            explicit shared(const vector_type &items) : refs(1), shareable(true), items(items) {}
+
+            explicit shared(vector_type &&items) : refs(1), shareable(true), items(std::move(items)) {}
+        };
+
+        shared *rep;
+
+        static const vector_type &nothing() {
+            static const vector_type items;
+            return items;
+        }
+
+        // releases this copy's share of the buffer.
+        void drop() {
+            if (rep != nullptr && rep->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete rep;
+        }
+
+        /**
+         * the elements, writable: clones them first if the buffer is shared.
+         * leak marks the buffer unshareable because a mutable reference escapes.
+         */
+        vector_type &mutate(bool leak = false) {
+            if (rep == nullptr) {
+                rep = new shared();
+            } else if (rep->refs.load(std::memory_order_acquire) != 1) {
+                shared *copy = new shared(rep->items);
+                drop();
+                rep = copy;
+            }
+            if (leak) rep->shareable = false;
+            return rep->items;
+        }
+    };
+
+    template<typename T, class Growth, size_t N, class Allocator>
+    bool operator==(const cow_vector<T, Growth, N, Allocator> &lhs, const cow_vector<T, Growth, N, Allocator> &rhs) {
+        return lhs.view() == rhs.view();
+    }
+
+    template<typename T, class Growth, size_t N, class Allocator>
+    bool operator!=(const cow_vector<T, Growth, N, Allocator> &lhs, const cow_vector<T, Growth, N, Allocator> &rhs) {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
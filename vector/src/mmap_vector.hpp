@@ -0,0 +1,297 @@
+#ifndef SJTU_MMAP_VECTOR_HPP
+#define SJTU_MMAP_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sjtu {
+/**
+ * a vector whose elements live in a file mapped into memory (Linux).
+ *
+ * the file is a 64-byte header followed by the elements exactly as they sit
+ * in memory, so reopening an existing file maps it back in O(1) with no
+ * deserialization, and the kernel pages records in on first touch. The file
+ * grows geometrically like vector's buffer; the slots past size() are zeros.
+ * every change is written to the shared mapping at once; sync() forces it to disk.
+ *
+ * T must be trivially copyable, since its bytes are read back in another process.
+ * a file written for another element size is rejected with runtime_error, as
+ * is any failing system call.
+ *
+ * a moved-from mmap_vector has no file: it is empty with no capacity, and
+ * growing it throws runtime_error. It can still be assigned to or destroyed.
+ */
+    template<typename T>
+    class mmap_vector {
+        static_assert(std::is_trivially_copyable<T>::value, "mmap_vector needs a trivially copyable T");
+        static_assert(alignof(T) <= 64, "mmap_vector aligns elements to 64 bytes at most");
+
+    public:
+        using iterator = typename vector<T>::iterator;
+        using const_iterator = typename vector<T>::const_iterator;
+
+        /**
+         * opens the file at path, creating an empty one if it does not exist.
+         */
+        explicit mmap_vector(const char *path) : fd(-1), base(nullptr), bytes(0) {
+            fd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (fd < 0) throw runtime_error();
+            try {
+                struct stat st;
+                if (::fstat(fd, &st) != 0) throw runtime_error();
+                if (st.st_size == 0) {
+                    resize(sizeof(header) + minCapacity * sizeof(T));
+                    header *h = new(base) header();
+                    std::memcpy(h->magic, fileMagic, sizeof(h->magic));
+                    h->elemSize = sizeof(T);
+                } else {
+                    if (size_t(st.st_size) < sizeof(header)) throw runtime_error();
+                    map(size_t(st.st_size));
+                    const header *h = head();
+                    if (std::memcmp(h->magic, fileMagic, sizeof(h->magic)) != 0 || h->elemSize != sizeof(T) ||
+                        h->length > capacity()) {
+                        throw runtime_error();
+                    }
+                }
+            } catch (...) {
+                unmap();
+                ::close(fd);
+                throw;
+            }
+        }
+
+        mmap_vector(const mmap_vector &) = delete;
+
+        mmap_vector &operator=(const mmap_vector &) = delete;
+
+        mmap_vector(mmap_vector &&other) noexcept : fd(other.fd), base(other.base), bytes(other.bytes) {
+            other.fd = -1;
+            other.base = nullptr;
+            other.bytes = 0;
+        }
+
+        mmap_vector &operator=(mmap_vector &&other) noexcept {
+            if (this == &other) return *this;
+            mmap_vector tmp(std::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        /**
+         * unmaps and closes the file; its contents stay on disk.
+         */
+        ~mmap_vector() {
+            unmap();
+            if (fd >= 0) ::close(fd);
+        }
+
+        void swap(mmap_vector &other) noexcept {
+            std::swap(fd, other.fd);
+            std::swap(base, other.base);
+            std::swap(bytes, other.bytes);
+        }
+
+        /**
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        T &at(const size_t &pos) {
+            if (pos >= size()) throw index_out_of_bound();
+            return data()[pos];
+        }
+
+        const T &at(const size_t &pos) const {
+            if (pos >= size()) throw index_out_of_bound();
+            return data()[pos];
+        }
+
+        T &operator[](const size_t &pos) {
+            return at(pos);
+        }
+
+        const T &operator[](const size_t &pos) const {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        const T &front() const {
+            if (empty()) throw container_is_empty();
+            return data()[0];
+        }
+
+        const T &back() const {
+            if (empty()) throw container_is_empty();
+            return data()[size() - 1];
+        }
+
+        iterator begin() {
+            return iterator(data());
+        }
+
+        const_iterator begin() const {
+            return const_iterator(data());
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(data());
+        }
+
+        iterator end() {
+            return iterator(data() + size());
+        }
+
+        const_iterator end() const {
+            return const_iterator(data() + size());
+        }
+
+        const_iterator cend() const {
+            return const_iterator(data() + size());
+        }
+
+        T *data() {
+            return base != nullptr ? reinterpret_cast<T *>(base + sizeof(header)) : nullptr;
+        }
+
+        const T *data() const {
+            return base != nullptr ? reinterpret_cast<const T *>(base + sizeof(header)) : nullptr;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        size_t size() const {
+            return base != nullptr ? size_t(head()->length) : 0;
+        }
+
+        /**
+         * the number of elements the file can hold before it has to grow.
+         */
+        size_t capacity() const {
+            return base != nullptr ? (bytes - sizeof(header)) / sizeof(T) : 0;
+        }
+
+        /**
+         * grows the file so that it holds at least n elements.
+         */
+        void reserve(size_t n) {
+            if (n > capacity()) resize(sizeof(header) + n * sizeof(T));
+        }
+
+        /**
+         * truncates the file to the elements in use.
+         */
+        void shrink_to_fit() {
+            if (capacity() > size()) resize(sizeof(header) + size() * sizeof(T));
+        }
+
+        /**
+         * removes every element; the file keeps its size.
+         */
+        void clear() {
+            if (base != nullptr) head()->length = 0;
+        }
+
+        void push_back(const T &value) {
+            emplace_back(value);
+        }
+
+        template<typename... Args>
+        T &emplace_back(Args &&...args) {
+            size_t len = size();
+            if (len == capacity()) {
+                // value may live in the mapping, which resize can move.
+                T tmp(std::forward<Args>(args)...);
+                resize(sizeof(header) + default_growth::grow(capacity(), len + 1) * sizeof(T));
+                new(data() + len) T(tmp);
+            } else {
+                new(data() + len) T(std::forward<Args>(args)...);
+            }
+            head()->length = len + 1;
+            return data()[len];
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back() {
+            if (empty()) throw container_is_empty();
+            --head()->length;
+        }
+
+        /**
+         * writes the mapping back to the file and waits for the disk.
+         */
+        void sync() {
+            if (::msync(base, bytes, MS_SYNC) != 0) throw runtime_error();
+        }
+
+    private:
+        struct header {
+            char magic[8];
+            std::uint64_t elemSize;
+            std::uint64_t length;
+            char reserved[40];
+        };
+
+        static_assert(sizeof(header) == 64, "the header occupies one cache line");
+
+        static constexpr char fileMagic[8] = {'S', 'J', 'T', 'U', 'M', 'V', '0', '1'};
+        static constexpr size_t minCapacity = 16;
+
+        int fd;
+        char *base;
+        size_t bytes;
+
+        // the header of the file; only valid while a file is mapped.
+        header *head() {
+            return reinterpret_cast<header *>(base);
+        }
+
+        const header *head() const {
+            return reinterpret_cast<const header *>(base);
+        }
+
+        // maps the first n bytes of the file, replacing any earlier mapping.
+        void map(size_t n) {
+            void *p;
+            if (base == nullptr) {
+                p = ::mmap(nullptr, n, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            } else {
+                p = ::mremap(base, bytes, n, MREMAP_MAYMOVE);
+            }
+            if (p == MAP_FAILED) throw runtime_error();
+            base = static_cast<char *>(p);
+            bytes = n;
+        }
+
+        void unmap() {
+            if (base != nullptr) ::munmap(base, bytes);
+            base = nullptr;
+            bytes = 0;
+        }
+
+        // sets the file size to n bytes and remaps it. A failed remap leaves the old mapping in place.
+        void resize(size_t n) {
+            size_t old = bytes;
+            if (n > old && ::ftruncate(fd, off_t(n)) != 0) throw runtime_error();
+            map(n);
+            if (n < old && ::ftruncate(fd, off_t(n)) != 0) throw runtime_error();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef SJTU_PARALLEL_HPP
+#define SJTU_PARALLEL_HPP
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+
+namespace sjtu {
+/**
+ * tag that opts an operation into running on several threads.
+ *
+ * the range is cut into one contiguous chunk per thread, and every thread gets
+ * at least threshold elements, so short ranges stay on the calling thread and
+ * never pay for starting one. threads == 0 means one per hardware thread.
+ *
+ *   sjtu::vector<int> copy(sjtu::parallel, big);
+ *   sjtu::vector<int> copy2(sjtu::parallel_t{1 << 20, 4}, big);
+ */
+    struct parallel_t {
+        size_t threshold = size_t(1) << 16;
+        unsigned threads = 0;
+
+        static constexpr unsigned maxThreads = 64;
+
+        /**
+         * the number of chunks a range of n elements is cut into; 1 means serial.
+         */
+        size_t chunks(size_t n) const {
+            size_t k = threads != 0 ? threads : std::thread::hardware_concurrency();
+            if (k > maxThreads) k = maxThreads;
+            size_t most = threshold != 0 ? n / threshold : n;
+            if (k > most) k = most;
+            return k != 0 ? k : 1;
+        }
+
+        /**
+         * chunk c of k over n elements is [begin(c), begin(c + 1)).
+         */
+        static size_t begin(size_t n, size_t k, size_t c) {
+            return n / k * c + n % k * c / k;
+        }
+
+        /**
+         * calls work(c) for every chunk c in [0, k): chunk k - 1 on the calling
+         * thread, the others on threads of their own. If any call throws, undo(c)
+         * is called for every chunk that completed, and the first exception is
+         * rethrown once all threads have finished.
+         * if a thread cannot be started, its chunk runs on the calling thread.
+         */
+        template<class Work, class Undo>
+        static void run(size_t k, Work work, Undo undo) {
+            std::thread workers[maxThreads];
+            std::exception_ptr errors[maxThreads];
+            auto guarded = [&](size_t c) {
+                try {
+                    work(c);
+                } catch (...) {
+                    errors[c] = std::current_exception();
+                }
+            };
+            for (size_t c = 0; c + 1 < k; ++c) {
+                try {
+                    workers[c] = std::thread(guarded, c);
+                } catch (...) {
+                    guarded(c);
+                }
+            }
+            guarded(k - 1);
+            size_t failed = k;
+            for (size_t c = 0; c < k; ++c) {
+                if (workers[c].joinable()) workers[c].join();
+                if (errors[c] && failed == k) failed = c;
+            }
+            if (failed == k) return;
+            for (size_t c = 0; c < k; ++c) {
+                if (!errors[c]) undo(c);
+            }
+            std::rethrow_exception(errors[failed]);
+        }
+    };
+
+    inline constexpr parallel_t parallel{};
+}
+
+#endif
@@ -0,0 +1,361 @@
+#ifndef SJTU_SIMD_HPP
+#define SJTU_SIMD_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(SJTU_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define SJTU_SIMD_AVX2 1
+#elif !defined(SJTU_NO_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#define SJTU_SIMD_SSE2 1
+#endif
+
+namespace sjtu {
+/**
+ * linear search, count, minimum, fill and equality kernels over contiguous
+ * arrays of arithmetic values, and a population count over bit words.
+ *
+ * with AVX2 enabled (-mavx2 or -march=native) they process 32 bytes per step,
+ * otherwise 16 bytes with SSE2, which every x86-64 target has. On any other
+ * target, or with SJTU_NO_SIMD defined, they are plain loops. The results are
+ * always the same as those of the plain loops, including for -0.0 and NaN.
+ */
+    namespace simd {
+        /**
+         * whether the kernels vectorize T: arithmetic types of 1, 2, 4 or 8 bytes, except bool.
+         */
+        template<typename T>
+        struct is_vectorizable : std::integral_constant<bool,
+                std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+                (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+#if defined(SJTU_SIMD_AVX2) || defined(SJTU_SIMD_SSE2)
+#define SJTU_SIMD_ENABLED 1
+
+#ifdef SJTU_SIMD_AVX2
+        using reg = __m256i;
+
+        constexpr size_t width = 32;
+
+        inline reg load(const void *p) { return _mm256_loadu_si256(static_cast<const reg *>(p)); }
+
+        inline void store(void *p, reg x) { _mm256_storeu_si256(static_cast<reg *>(p), x); }
+
+        inline unsigned mask(reg x) { return unsigned(_mm256_movemask_epi8(x)); }
+
+        inline reg bitAnd(reg a, reg b) { return _mm256_and_si256(a, b); }
+
+        inline reg bitOr(reg a, reg b) { return _mm256_or_si256(a, b); }
+
+        inline reg bitAndNot(reg a, reg b) { return _mm256_andnot_si256(a, b); }
+
+        inline reg bitXor(reg a, reg b) { return _mm256_xor_si256(a, b); }
+
+        template<size_t S>
+        reg splatBits(const void *bits) {
+            if constexpr (S == 1) { char x; std::memcpy(&x, bits, 1); return _mm256_set1_epi8(x); }
+            if constexpr (S == 2) { short x; std::memcpy(&x, bits, 2); return _mm256_set1_epi16(x); }
+            if constexpr (S == 4) { int x; std::memcpy(&x, bits, 4); return _mm256_set1_epi32(x); }
+            if constexpr (S == 8) { long long x; std::memcpy(&x, bits, 8); return _mm256_set1_epi64x(x); }
+        }
+
+        template<typename T>
+        reg same(reg a, reg b) {
+            if constexpr (std::is_same<T, float>::value) {
+                return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+            } else if constexpr (std::is_same<T, double>::value) {
+                return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+            } else if constexpr (sizeof(T) == 1) {
+                return _mm256_cmpeq_epi8(a, b);
+            } else if constexpr (sizeof(T) == 2) {
+                return _mm256_cmpeq_epi16(a, b);
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm256_cmpeq_epi32(a, b);
+            } else {
+                return _mm256_cmpeq_epi64(a, b);
+            }
+        }
+
+        // signed a > b lane by lane.
+        template<size_t S>
+        reg greater(reg a, reg b) {
+            if constexpr (S == 1) return _mm256_cmpgt_epi8(a, b);
+            if constexpr (S == 2) return _mm256_cmpgt_epi16(a, b);
+            if constexpr (S == 4) return _mm256_cmpgt_epi32(a, b);
+            if constexpr (S == 8) return _mm256_cmpgt_epi64(a, b);
+        }
+
+        template<size_t S>
+        reg sub(reg a, reg b) {
+            if constexpr (S == 1) return _mm256_sub_epi8(a, b);
+            if constexpr (S == 2) return _mm256_sub_epi16(a, b);
+            if constexpr (S == 4) return _mm256_sub_epi32(a, b);
+            if constexpr (S == 8) return _mm256_sub_epi64(a, b);
+        }
+
+        inline reg add64(reg a, reg b) { return _mm256_add_epi64(a, b); }
+
+        // the number of set bits in every byte, looked up one nibble at a time.
+        inline reg bytePopcount(reg x) {
+            const reg table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const reg low = _mm256_set1_epi8(0x0f);
+            return _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(x, low)),
+                                   _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(x, 4), low)));
+        }
+
+        // the sum of each group of eight bytes, in the 64-bit lanes.
+        inline reg sumBytes(reg x) { return _mm256_sad_epu8(x, _mm256_setzero_si256()); }
+
+        constexpr bool hasGreater64 = true;
+#else
+        using reg = __m128i;
+
+        constexpr size_t width = 16;
+
+        inline reg load(const void *p) { return _mm_loadu_si128(static_cast<const reg *>(p)); }
+
+        inline void store(void *p, reg x) { _mm_storeu_si128(static_cast<reg *>(p), x); }
+
+        inline unsigned mask(reg x) { return unsigned(_mm_movemask_epi8(x)); }
+
+        inline reg bitAnd(reg a, reg b) { return _mm_and_si128(a, b); }
+
+        inline reg bitOr(reg a, reg b) { return _mm_or_si128(a, b); }
+
+        inline reg bitAndNot(reg a, reg b) { return _mm_andnot_si128(a, b); }
+
+        inline reg bitXor(reg a, reg b) { return _mm_xor_si128(a, b); }
+
+        template<size_t S>
+        reg splatBits(const void *bits) {
+            if constexpr (S == 1) { char x; std::memcpy(&x, bits, 1); return _mm_set1_epi8(x); }
+            if constexpr (S == 2) { short x; std::memcpy(&x, bits, 2); return _mm_set1_epi16(x); }
+            if constexpr (S == 4) { int x; std::memcpy(&x, bits, 4); return _mm_set1_epi32(x); }
+            if constexpr (S == 8) { long long x; std::memcpy(&x, bits, 8); return _mm_set1_epi64x(x); }
+        }
+
+        template<typename T>
+        reg same(reg a, reg b) {
+            if constexpr (std::is_same<T, float>::value) {
+                return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+            } else if constexpr (std::is_same<T, double>::value) {
+                return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+            } else if constexpr (sizeof(T) == 1) {
+                return _mm_cmpeq_epi8(a, b);
+            } else if constexpr (sizeof(T) == 2) {
+                return _mm_cmpeq_epi16(a, b);
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm_cmpeq_epi32(a, b);
+            } else {
+                // SSE2 has no 64-bit compare: both 32-bit halves must match.
+                reg e = _mm_cmpeq_epi32(a, b);
+                return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+        }
+
+        // signed a > b lane by lane; 64-bit lanes are not available.
+        template<size_t S>
+        reg greater(reg a, reg b) {
+            if constexpr (S == 1) return _mm_cmpgt_epi8(a, b);
+            if constexpr (S == 2) return _mm_cmpgt_epi16(a, b);
+            if constexpr (S == 4) return _mm_cmpgt_epi32(a, b);
+        }
+
+        template<size_t S>
+        reg sub(reg a, reg b) {
+            if constexpr (S == 1) return _mm_sub_epi8(a, b);
+            if constexpr (S == 2) return _mm_sub_epi16(a, b);
+            if constexpr (S == 4) return _mm_sub_epi32(a, b);
+            if constexpr (S == 8) return _mm_sub_epi64(a, b);
+        }
+
+        inline reg add64(reg a, reg b) { return _mm_add_epi64(a, b); }
+
+        // the number of set bits in every byte; SSE2 has no byte shuffle, so the bits are added in halves.
+        inline reg bytePopcount(reg x) {
+            x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi64(x, 1), _mm_set1_epi8(0x55)));
+            x = _mm_add_epi8(_mm_and_si128(x, _mm_set1_epi8(0x33)), _mm_and_si128(_mm_srli_epi64(x, 2), _mm_set1_epi8(0x33)));
+            return _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi64(x, 4)), _mm_set1_epi8(0x0f));
+        }
+
+        inline reg sumBytes(reg x) { return _mm_sad_epu8(x, _mm_setzero_si128()); }
+
+        constexpr bool hasGreater64 = false;
+#endif
+
+        // the unsigned integer as wide as one lane of S bytes.
+        template<size_t S> struct lane_uint;
+        template<> struct lane_uint<1> { using type = unsigned char; };
+        template<> struct lane_uint<2> { using type = unsigned short; };
+        template<> struct lane_uint<4> { using type = unsigned int; };
+        template<> struct lane_uint<8> { using type = unsigned long long; };
+
+        template<typename T>
+        reg splat(const T &value) {
+            return splatBits<sizeof(T)>(&value);
+        }
+
+        // the number of T in one register.
+        template<typename T>
+        constexpr size_t lanes() {
+            return width / sizeof(T);
+        }
+#endif
+
+        /**
+         * returns a pointer to the first element equal to value, or last.
+         */
+        template<typename T>
+        const T *find(const T *first, const T *last, const T &value) {
+#ifdef SJTU_SIMD_ENABLED
+            if constexpr (is_vectorizable<T>::value) {
+                reg v = splat(value);
+                for (; size_t(last - first) >= lanes<T>(); first += lanes<T>()) {
+                    unsigned m = mask(same<T>(load(first), v));
+                    if (m != 0) return first + __builtin_ctz(m) / sizeof(T);
+                }
+            }
+#endif
+            for (; first != last; ++first) {
+                if (*first == value) return first;
+            }
+            return last;
+        }
+
+        /**
+         * returns the number of elements equal to value.
+         */
+        template<typename T>
+        size_t count(const T *first, const T *last, const T &value) {
+            size_t cnt = 0;
+#ifdef SJTU_SIMD_ENABLED
+            if constexpr (is_vectorizable<T>::value) {
+                using U = typename lane_uint<sizeof(T)>::type;
+                reg v = splat(value);
+                while (size_t(last - first) >= lanes<T>()) {
+                    // a matching lane is all ones, i.e. -1, so subtracting it counts the match.
+                    // lanes are flushed before even a one-byte lane can wrap around.
+                    reg acc = splat(U(0));
+                    for (int i = 0; i < 255 && size_t(last - first) >= lanes<T>(); ++i, first += lanes<T>()) {
+                        acc = sub<sizeof(T)>(acc, same<T>(load(first), v));
+                    }
+                    U part[lanes<T>()];
+                    store(part, acc);
+                    for (size_t i = 0; i < lanes<T>(); ++i) cnt += part[i];
+                }
+            }
+#endif
+            for (; first != last; ++first) {
+                if (*first == value) ++cnt;
+            }
+            return cnt;
+        }
+
+        /**
+         * returns a pointer to the first smallest element, or last if the range is empty.
+         * only integers are vectorized: with NaNs around, the result of a
+         * sequential scan depends on the order of comparisons.
+         */
+        template<typename T>
+        const T *min_element(const T *first, const T *last) {
+            if (first == last) return last;
+#ifdef SJTU_SIMD_ENABLED
+            if constexpr (is_vectorizable<T>::value && std::is_integral<T>::value &&
+                          (sizeof(T) != 8 || hasGreater64)) {
+                if (size_t(last - first) >= lanes<T>()) {
+                    // unsigned lanes compare as signed ones once the sign bits are flipped.
+                    using U = typename std::make_unsigned<T>::type;
+                    U signBit = std::is_unsigned<T>::value ? U(U(1) << (sizeof(T) * CHAR_BIT - 1)) : U(0);
+                    reg flip = splat(signBit);
+                    const T *p = first;
+                    reg best = bitXor(load(p), flip);
+                    for (p += lanes<T>(); size_t(last - p) >= lanes<T>(); p += lanes<T>()) {
+                        reg x = bitXor(load(p), flip);
+                        reg gt = greater<sizeof(T)>(best, x);
+                        best = bitOr(bitAnd(gt, x), bitAndNot(gt, best));
+                    }
+                    T part[lanes<T>()];
+                    store(part, bitXor(best, flip));
+                    T low = part[0];
+                    for (size_t i = 1; i < lanes<T>(); ++i) {
+                        if (part[i] < low) low = part[i];
+                    }
+                    for (; p != last; ++p) {
+                        if (*p < low) low = *p;
+                    }
+                    return find(first, last, low);
+                }
+            }
+#endif
+            const T *low = first;
+            for (++first; first != last; ++first) {
+                if (*first < *low) low = first;
+            }
+            return low;
+        }
+
+        /**
+         * assigns value to every element of [first, last).
+         */
+        template<typename T>
+        void fill(T *first, T *last, const T &value) {
+#ifdef SJTU_SIMD_ENABLED
+            if constexpr (is_vectorizable<T>::value) {
+                reg v = splat(value);
+                for (; size_t(last - first) >= lanes<T>(); first += lanes<T>()) {
+                    store(first, v);
+                }
+            }
+#endif
+            for (; first != last; ++first) *first = value;
+        }
+
+        /**
+         * whether a[i] == b[i] for every i < n.
+         */
+        template<typename T>
+        bool equal(const T *a, const T *b, size_t n) {
+            size_t i = 0;
+#ifdef SJTU_SIMD_ENABLED
+            if constexpr (is_vectorizable<T>::value) {
+                const unsigned all = unsigned((1ull << width) - 1);
+                for (; n - i >= lanes<T>(); i += lanes<T>()) {
+                    if (mask(same<T>(load(a + i), load(b + i))) != all) return false;
+                }
+            }
+#endif
+            for (; i < n; ++i) {
+                if (!(a[i] == b[i])) return false;
+            }
+            return true;
+        }
+
+        /**
+         * returns the number of set bits in words[0, n).
+         */
+        inline size_t popcount(const std::uint64_t *words, size_t n) {
+            size_t cnt = 0, i = 0;
+#ifdef SJTU_SIMD_ENABLED
+            const size_t step = width / sizeof(std::uint64_t);
+            if (n >= step) {
+                // byte counts are at most 8, so they are summed into 64-bit lanes at every step.
+                reg acc = splat(std::uint64_t(0));
+                for (; n - i >= step; i += step) acc = add64(acc, sumBytes(bytePopcount(load(words + i))));
+                std::uint64_t part[step];
+                store(part, acc);
+                for (size_t j = 0; j < step; ++j) cnt += size_t(part[j]);
+            }
+#endif
+            for (; i < n; ++i) cnt += size_t(__builtin_popcountll(words[i]));
+            return cnt;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,492 @@
+#ifndef SJTU_STABLE_VECTOR_HPP
+#define SJTU_STABLE_VECTOR_HPP
+
+#include "allocator.hpp"
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+/**
+ * the default number of elements per chunk of a stable_vector: the largest
+ * power of two whose chunk still fits in about 4 KB, but at least 8.
+ */
+    constexpr size_t stable_vector_chunk(size_t elemSize) {
+        size_t n = 8;
+        while (n * 2 * elemSize <= 4096) n *= 2;
+        return n;
+    }
+
+/**
+ * a segmented vector: elements live in fixed-size chunks of ChunkSize slots and
+ * a table of chunk pointers gives O(1) random access (index >> shift, index & mask).
+ *
+ * chunks never move once allocated, so pointers and references to existing
+ * elements stay valid across push_back / emplace_back / pop_back /
+ * reserve. Inserting or erasing in the middle would have to shift elements
+ * between addresses, so those are deliberately not offered.
+ * memory is allocated once per chunk, never per element; the chunks and the
+ * table both come from Allocator.
+ *
+ * iterators hold the table and an index, so they survive a move or swap of
+ * the container, and any push_back that does not need a new chunk. Adding a
+ * chunk may move the table, which invalidates iterators as in std::deque.
+ */
+    template<typename T, size_t ChunkSize = stable_vector_chunk(sizeof(T)), class Allocator = allocator<T>>
+    class stable_vector : private Allocator {
+        static_assert(ChunkSize != 0 && (ChunkSize & (ChunkSize - 1)) == 0, "chunk size must be a power of two");
+
+        using table_allocator = typename rebind_allocator<Allocator, T *>::type;
+
+    public:
+        class const_iterator;
+
+        class iterator {
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = T;
+            using pointer = T *;
+            using reference = T &;
+            using iterator_category = std::random_access_iterator_tag;
+
+            T *const *table;
+            size_t index;
+
+            iterator() : table(nullptr), index(0) {}
+
+            iterator(T *const *table, size_t index) : table(table), index(index) {}
+
+            iterator operator+(difference_type n) const {
+                return iterator(table, index + n);
+            }
+
+            friend iterator operator+(difference_type n, const iterator &it) {
+                return iterator(it.table, it.index + n);
+            }
+
+            iterator operator-(difference_type n) const {
+                return iterator(table, index - n);
+            }
+
+            difference_type operator-(const iterator &rhs) const {
+                return difference_type(index) - difference_type(rhs.index);
+            }
+
+            iterator &operator+=(difference_type n) {
+                index += n;
+                return *this;
+            }
+
+            iterator &operator-=(difference_type n) {
+                index -= n;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator tmp = *this;
+                ++index;
+                return tmp;
+            }
+
+            iterator &operator++() {
+                ++index;
+                return *this;
+            }
+
+            iterator operator--(int) {
+                iterator tmp = *this;
+                --index;
+                return tmp;
+            }
+
+            iterator &operator--() {
+                --index;
+                return *this;
+            }
+
+            T &operator*() const {
+                return table[index / ChunkSize][index % ChunkSize];
+            }
+
+            T *operator->() const {
+                return &**this;
+            }
+
+            T &operator[](difference_type n) const {
+                return *(*this + n);
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return index == rhs.index;
+            }
+
+            bool operator==(const const_iterator &rhs) const {
+                return index == rhs.index;
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return index != rhs.index;
+            }
+
+            bool operator!=(const const_iterator &rhs) const {
+                return index != rhs.index;
+            }
+
+            bool operator<(const iterator &rhs) const {
+                return index < rhs.index;
+            }
+
+            bool operator>(const iterator &rhs) const {
+                return index > rhs.index;
+            }
+
+            bool operator<=(const iterator &rhs) const {
+                return index <= rhs.index;
+            }
+
+            bool operator>=(const iterator &rhs) const {
+                return index >= rhs.index;
+            }
+        };
+
+        class const_iterator {
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = T;
+            using pointer = const T *;
+            using reference = const T &;
+            using iterator_category = std::random_access_iterator_tag;
+
+            T *const *table;
+            size_t index;
+
+            const_iterator() : table(nullptr), index(0) {}
+
+            const_iterator(T *const *table, size_t index) : table(table), index(index) {}
+
+            const_iterator(const iterator &it) : table(it.table), index(it.index) {}
+
+            const_iterator operator+(difference_type n) const {
+                return const_iterator(table, index + n);
+            }
+
+            friend const_iterator operator+(difference_type n, const const_iterator &it) {
+                return const_iterator(it.table, it.index + n);
+            }
+
+            const_iterator operator-(difference_type n) const {
+                return const_iterator(table, index - n);
+            }
+
+            difference_type operator-(const const_iterator &rhs) const {
+                return difference_type(index) - difference_type(rhs.index);
+            }
+
+            const_iterator &operator+=(difference_type n) {
+                index += n;
+                return *this;
+            }
+
+            const_iterator &operator-=(difference_type n) {
+                index -= n;
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator tmp = *this;
+                ++index;
+                return tmp;
+            }
+
+            const_iterator &operator++() {
+                ++index;
+                return *this;
+            }
+
+            const_iterator operator--(int) {
+                const_iterator tmp = *this;
+                --index;
+                return tmp;
+            }
+
+            const_iterator &operator--() {
+                --index;
+                return *this;
+            }
+
+            const T &operator*() const {
+                return table[index / ChunkSize][index % ChunkSize];
+            }
+
+            const T *operator->() const {
+                return &**this;
+            }
+
+            const T &operator[](difference_type n) const {
+                return *(*this + n);
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return index == rhs.index;
+            }
+
+            bool operator==(const const_iterator &rhs) const {
+                return index == rhs.index;
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return index != rhs.index;
+            }
+
+            bool operator!=(const const_iterator &rhs) const {
+                return index != rhs.index;
+            }
+
+            bool operator<(const const_iterator &rhs) const {
+                return index < rhs.index;
+            }
+
+            bool operator>(const const_iterator &rhs) const {
+                return index > rhs.index;
+            }
+
+            bool operator<=(const const_iterator &rhs) const {
+                return index <= rhs.index;
+            }
+
+            bool operator>=(const const_iterator &rhs) const {
+                return index >= rhs.index;
+            }
+        };
+
+        stable_vector() : curLen(0) {}
+
+        explicit stable_vector(const Allocator &alloc) : Allocator(alloc), chunks(table_allocator(alloc)), curLen(0) {}
+
+        stable_vector(const stable_vector &other)
+                : Allocator(other.allocRef()), chunks(table_allocator(other.allocRef())), curLen(0) {
+            try {
+                reserve(other.curLen);
+                for (; curLen < other.curLen; ++curLen) {
+                    new(slot(curLen)) T(other[curLen]);
+                }
+            } catch (...) {
+                freeAll();
+                throw;
+            }
+        }
+
+        /**
+         * takes over the chunks of other; elements keep their addresses.
+         */
+        stable_vector(stable_vector &&other) noexcept
+                : Allocator(other.allocRef()), chunks(std::move(other.chunks)), curLen(other.curLen) {
+            other.curLen = 0;
+        }
+
+        ~stable_vector() {
+            freeAll();
+        }
+
+        stable_vector &operator=(const stable_vector &other) {
+            if (this == &other) return *this;
+            stable_vector tmp(other);
+            swap(tmp);
+            return *this;
+        }
+
+        stable_vector &operator=(stable_vector &&other) noexcept {
+            if (this == &other) return *this;
+            stable_vector tmp(std::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        void swap(stable_vector &other) noexcept {
+            Allocator f0 = allocRef();
+            allocRef() = other.allocRef();
+            other.allocRef() = f0;
+
+            chunks.swap(other.chunks);
+
+            size_t f1 = curLen;
+            curLen = other.curLen;
+            other.curLen = f1;
+        }
+
+        /**
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        T &at(const size_t &pos) {
+            if (pos >= curLen) throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        const T &at(const size_t &pos) const {
+            if (pos >= curLen) throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        T &operator[](const size_t &pos) {
+            return at(pos);
+        }
+
+        const T &operator[](const size_t &pos) const {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        const T &front() const {
+            if (empty()) throw container_is_empty();
+            return *slot(0);
+        }
+
+        const T &back() const {
+            if (empty()) throw container_is_empty();
+            return *slot(curLen - 1);
+        }
+
+        iterator begin() {
+            return iterator(chunks.data(), 0);
+        }
+
+        const_iterator begin() const {
+            return const_iterator(chunks.data(), 0);
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(chunks.data(), 0);
+        }
+
+        iterator end() {
+            return iterator(chunks.data(), curLen);
+        }
+
+        const_iterator end() const {
+            return const_iterator(chunks.data(), curLen);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(chunks.data(), curLen);
+        }
+
+        bool empty() const {
+            return curLen == 0;
+        }
+
+        size_t size() const {
+            return curLen;
+        }
+
+        /**
+         * the number of slots in the allocated chunks.
+         */
+        size_t capacity() const {
+            return chunks.size() * ChunkSize;
+        }
+
+        /**
+         * allocates enough chunks for n elements.
+         */
+        void reserve(size_t n) {
+            while (capacity() < n) addChunk();
+        }
+
+        /**
+         * frees every chunk that holds no element.
+         */
+        void shrink_to_fit() {
+            size_t used = (curLen + ChunkSize - 1) / ChunkSize;
+            while (chunks.size() > used) {
+                deallocate(chunks.data()[chunks.size() - 1]);
+                chunks.pop_back();
+            }
+            chunks.shrink_to_fit();
+        }
+
+        /**
+         * destroys every element; the chunks are kept for reuse.
+         */
+        void clear() {
+            if constexpr (!std::is_trivially_destructible<T>::value) {
+                for (size_t i = 0; i < curLen; ++i) slot(i)->~T();
+            }
+            curLen = 0;
+        }
+
+        void push_back(const T &value) {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value) {
+            emplace_back(std::move(value));
+        }
+
+        /**
+         * constructs an element at the end; no existing element moves.
+         * returns a reference to the new element.
+         */
+        template<typename... Args>
+        T &emplace_back(Args &&...args) {
+            if (curLen == capacity()) addChunk();
+            T *p = slot(curLen);
+            new(p) T(std::forward<Args>(args)...);
+            ++curLen;
+            return *p;
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back() {
+            if (empty()) throw container_is_empty();
+            --curLen;
+            slot(curLen)->~T();
+        }
+
+    private:
+        vector<T *, default_growth, 0, table_allocator> chunks;
+        size_t curLen;
+
+        T *slot(size_t i) const {
+            return chunks.data()[i / ChunkSize] + i % ChunkSize;
+        }
+
+        Allocator &allocRef() {
+            return *this;
+        }
+
+        const Allocator &allocRef() const {
+            return *this;
+        }
+
+        void deallocate(T *chunk) {
+            allocRef().deallocate(chunk, ChunkSize);
+        }
+
+        void addChunk() {
+            T *chunk = allocRef().allocate(ChunkSize);
+            try {
+                chunks.push_back(chunk);
+            } catch (...) {
+                deallocate(chunk);
+                throw;
+            }
+        }
+
+        void freeAll() {
+            clear();
+            for (size_t i = 0; i < chunks.size(); ++i) deallocate(chunks.data()[i]);
+            chunks.clear();
+        }
+    };
+}
+
+#endif
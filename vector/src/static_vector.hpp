@@ -0,0 +1,539 @@
+#ifndef SJTU_STATIC_VECTOR_HPP
+#define SJTU_STATIC_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "type_traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+/**
+ * the slots and length of a static_vector.
+ *
+ * for trivial T the slots are a plain array, zeroed on construction, so the
+ * static_vector is a literal type and every operation can run in a constant
+ * expression. Otherwise they are raw bytes holding objects built with
+ * placement-new, and copying, moving or destroying the storage touches
+ * exactly the live elements.
+ */
+    template<typename T, size_t N, bool = std::is_trivial<T>::value>
+    struct static_vector_storage {
+        T items[N != 0 ? N : 1] {};
+        size_t curLen = 0;
+
+        constexpr T *slots() {
+            return items;
+        }
+
+        constexpr const T *slots() const {
+            return items;
+        }
+    };
+
+    template<typename T, size_t N>
+    struct static_vector_storage<T, N, false> {
+        alignas(T) unsigned char bytes[(N != 0 ? N : 1) * sizeof(T)];
+        size_t curLen;
+
+        static_vector_storage() : curLen(0) {}
+
+        /**
+         * no destructor runs for a constructor that throws, so if a copy
+         * throws, the copies made so far are destroyed here.
+         */
+        static_vector_storage(const static_vector_storage &other) : curLen(0) {
+            try {
+                copyFrom(other);
+            } catch (...) {
+                destroyAll();
+                throw;
+            }
+        }
+
+        /**
+         * moves the elements of other one by one; other is left empty.
+         * if a move throws, the elements moved so far are destroyed.
+         */
+        static_vector_storage(static_vector_storage &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+                : curLen(0) {
+            if constexpr (std::is_nothrow_move_constructible<T>::value) {
+                moveFrom(other);
+            } else {
+                try {
+                    moveFrom(other);
+                } catch (...) {
+                    destroyAll();
+                    throw;
+                }
+            }
+        }
+
+        ~static_vector_storage() {
+            destroyAll();
+        }
+
+        static_vector_storage &operator=(const static_vector_storage &other) {
+            if (this == &other) return *this;
+            destroyAll();
+            copyFrom(other);
+            return *this;
+        }
+
+        static_vector_storage &operator=(static_vector_storage &&other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+            if (this == &other) return *this;
+            destroyAll();
+            moveFrom(other);
+            return *this;
+        }
+
+        T *slots() {
+            return reinterpret_cast<T *>(bytes);
+        }
+
+        const T *slots() const {
+            return reinterpret_cast<const T *>(bytes);
+        }
+
+        void destroyAll() {
+            for (size_t i = 0; i < curLen; ++i) slots()[i].~T();
+            curLen = 0;
+        }
+
+        // copies the elements of other into this empty storage; if a copy throws, the
+        // copies made so far stay counted in curLen for the caller to keep or destroy.
+        void copyFrom(const static_vector_storage &other) {
+            for (; curLen < other.curLen; ++curLen) new(slots() + curLen) T(other.slots()[curLen]);
+        }
+
+        void moveFrom(static_vector_storage &other) {
+            for (; curLen < other.curLen; ++curLen) new(slots() + curLen) T(std::move(other.slots()[curLen]));
+            other.destroyAll();
+        }
+    };
+
+/**
+ * a vector with a fixed capacity of N elements, all stored inside the object,
+ * so it never touches the heap. The interface follows sjtu::vector; iterators
+ * are plain pointers.
+ *
+ * growing past N throws runtime_error, and a bad index throws
+ * index_out_of_bound as in vector; both are checked before anything changes.
+ *
+ * for trivial T (e.g. int, double, plain structs) every member is constexpr,
+ * so a static_vector can be filled in a constant expression:
+ *
+ *   constexpr sjtu::static_vector<int, 8> squares() {
+ *       sjtu::static_vector<int, 8> v;
+ *       for (int i = 0; i < 8; ++i) v.push_back(i * i);
+ *       return v;
+ *   }
+ */
+    template<typename T, size_t N>
+    class static_vector : private static_vector_storage<T, N> {
+    public:
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        constexpr static_vector() = default;
+
+        /**
+         * count copies of value.
+         * throw runtime_error if count > N
+         */
+        constexpr static_vector(size_t count, const T &value) : static_vector() {
+            insert(end(), count, value);
+        }
+
+        void swap(static_vector &other) {
+            static_vector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+        /**
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        constexpr T &at(const size_t &pos) {
+            if (pos >= size()) { throw index_out_of_bound(); }
+            return this->slots()[pos];
+        }
+
+        constexpr const T &at(const size_t &pos) const {
+            if (pos >= size()) { throw index_out_of_bound(); }
+            return this->slots()[pos];
+        }
+
+        constexpr T &operator[](const size_t &pos) {
+            return at(pos);
+        }
+
+        constexpr const T &operator[](const size_t &pos) const {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        constexpr const T &front() const {
+            if (empty()) { throw container_is_empty(); }
+            return this->slots()[0];
+        }
+
+        constexpr const T &back() const {
+            if (empty()) { throw container_is_empty(); }
+            return this->slots()[size() - 1];
+        }
+
+        constexpr iterator begin() {
+            return this->slots();
+        }
+
+        constexpr const_iterator begin() const {
+            return this->slots();
+        }
+
+        constexpr const_iterator cbegin() const {
+            return this->slots();
+        }
+
+        constexpr iterator end() {
+            return this->slots() + size();
+        }
+
+        constexpr const_iterator end() const {
+            return this->slots() + size();
+        }
+
+        constexpr const_iterator cend() const {
+            return this->slots() + size();
+        }
+
+        constexpr T *data() {
+            return this->slots();
+        }
+
+        constexpr const T *data() const {
+            return this->slots();
+        }
+
+        constexpr bool empty() const {
+            return size() == 0;
+        }
+
+        constexpr size_t size() const {
+            return this->curLen;
+        }
+
+        static constexpr size_t capacity() {
+            return N;
+        }
+
+        static constexpr size_t max_size() {
+            return N;
+        }
+
+        /**
+         * the capacity is fixed: this only checks that n elements fit.
+         * throw runtime_error if n > N
+         */
+        constexpr void reserve(size_t n) {
+            if (n > N) throw runtime_error();
+        }
+
+        constexpr void shrink_to_fit() {}
+
+        constexpr void clear() {
+            if constexpr (trivial) {
+                this->curLen = 0;
+            } else {
+                this->destroyAll();
+            }
+        }
+
+        constexpr iterator insert(iterator pos, const T &value) {
+            return emplace(pos, value);
+        }
+
+        constexpr iterator insert(iterator pos, T &&value) {
+            return emplace(pos, std::move(value));
+        }
+
+        /**
+         * constructs an element from args directly before pos.
+         * throw runtime_error if the vector is full
+         */
+        template<typename... Args>
+        constexpr iterator emplace(iterator pos, Args &&...args) {
+            size_t ind = pos - begin();
+            if (size() == N) throw runtime_error();
+            if constexpr (trivial) {
+                // args may refer to an element that the shift overwrites.
+                T tmp(std::forward<Args>(args)...);
+                for (size_t i = size(); i > ind; --i) this->slots()[i] = this->slots()[i - 1];
+                this->slots()[ind] = tmp;
+                ++this->curLen;
+            } else if constexpr (relocatable) {
+                // build the element aside first, so that a throwing constructor leaves
+                // the vector untouched and args may refer to an element that moves.
+                alignas(T) unsigned char tmp[sizeof(T)];
+                new(tmp) T(std::forward<Args>(args)...);
+                std::memmove(static_cast<void *>(begin() + ind + 1), begin() + ind, (size() - ind) * sizeof(T));
+                std::memcpy(static_cast<void *>(begin() + ind), tmp, sizeof(T));
+                ++this->curLen;
+            } else {
+                new(end()) T(std::forward<Args>(args)...);
+                ++this->curLen;
+                std::rotate(begin() + ind, end() - 1, end());
+            }
+            return begin() + ind;
+        }
+
+        /**
+         * throw index_out_of_bound if ind > size
+         */
+        constexpr iterator insert(const size_t &ind, const T &value) {
+            if (ind > size()) throw index_out_of_bound();
+            return insert(begin() + ind, value);
+        }
+
+        // iterators are pointers, so a literal 0 would also match insert(iterator, T &&).
+        constexpr iterator insert(const size_t &ind, T &&value) {
+            if (ind > size()) throw index_out_of_bound();
+            return insert(begin() + ind, std::move(value));
+        }
+
+        /**
+         * inserts count copies of value before pos.
+         * throw runtime_error if they do not fit
+         */
+        constexpr iterator insert(iterator pos, size_t count, const T &value) {
+            size_t ind = pos - begin();
+            if (count > N - size()) throw runtime_error();
+            if constexpr (trivial) {
+                T tmp(value);
+                for (size_t i = size(); i > ind; --i) this->slots()[i - 1 + count] = this->slots()[i - 1];
+                for (size_t i = ind; i < ind + count; ++i) this->slots()[i] = tmp;
+                this->curLen += count;
+            } else {
+                // value may be an element that the insertion moves.
+                T tmp(value);
+                insertElements(ind, count, [&tmp](T *dest) { new(dest) T(tmp); });
+            }
+            return begin() + ind;
+        }
+
+        /**
+         * inserts a copy of [first, last) before pos.
+         * first and last must be forward iterators that do not point into this vector.
+         * throw runtime_error if the elements do not fit
+         */
+        template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        constexpr iterator insert(iterator pos, InputIt first, InputIt last) {
+            size_t ind = pos - begin();
+            size_t count = 0;
+            for (InputIt it = first; it != last; ++it) ++count;
+            if (count > N - size()) throw runtime_error();
+            if constexpr (trivial) {
+                for (size_t i = size(); i > ind; --i) this->slots()[i - 1 + count] = this->slots()[i - 1];
+                for (size_t i = ind; first != last; ++first, ++i) this->slots()[i] = *first;
+                this->curLen += count;
+            } else {
+                insertElements(ind, count, [&first](T *dest) {
+                    new(dest) T(*first);
+                    ++first;
+                });
+            }
+            return begin() + ind;
+        }
+
+        /**
+         * replaces the contents with a copy of [first, last).
+         * throw runtime_error if the elements do not fit; the vector is left unchanged then.
+         */
+        template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        constexpr void assign(InputIt first, InputIt last) {
+            size_t count = 0;
+            for (InputIt it = first; it != last; ++it) ++count;
+            if (count > N) throw runtime_error();
+            clear();
+            insert(end(), first, last);
+        }
+
+        constexpr iterator erase(iterator pos) {
+            return erase(pos, pos + 1);
+        }
+
+        /**
+         * throw index_out_of_bound if ind >= size
+         */
+        constexpr iterator erase(const size_t &ind) {
+            if (ind >= size()) throw index_out_of_bound();
+            return erase(begin() + ind);
+        }
+
+        /**
+         * removes the elements in [first, last); the tail is shifted once.
+         */
+        constexpr iterator erase(iterator first, iterator last) {
+            size_t ind = first - begin();
+            size_t count = last - first;
+            if (count == 0) return first;
+            if constexpr (trivial) {
+                for (size_t i = ind; i + count < size(); ++i) this->slots()[i] = this->slots()[i + count];
+                this->curLen -= count;
+            } else if constexpr (relocatable) {
+                for (T *p = first; p != last; ++p) p->~T();
+                std::memmove(static_cast<void *>(first), last, (end() - last) * sizeof(T));
+                this->curLen -= count;
+            } else {
+                std::move(last, end(), first);
+                truncate(size() - count);
+            }
+            return begin() + ind;
+        }
+
+        /**
+         * keeps only the elements for which keep(element) is true, preserving
+         * their order, in one pass. returns the number of elements removed.
+         * if keep throws, the elements not yet visited are kept.
+         */
+        template<class Pred>
+        size_t retain(Pred keep) {
+            size_t w = 0, r = 0;
+            try {
+                for (; r < size(); ++r) {
+                    if (keep(this->slots()[r])) {
+                        if (w != r) this->slots()[w] = std::move(this->slots()[r]);
+                        ++w;
+                    }
+                }
+            } catch (...) {
+                if (w != r) {
+                    std::move(begin() + r, end(), begin() + w);
+                    truncate(size() - (r - w));
+                }
+                throw;
+            }
+            size_t removed = size() - w;
+            truncate(w);
+            return removed;
+        }
+
+        /**
+         * throw runtime_error if the vector is full
+         */
+        constexpr void push_back(const T &value) {
+            emplace_back(value);
+        }
+
+        constexpr void push_back(T &&value) {
+            emplace_back(std::move(value));
+        }
+
+        template<typename... Args>
+        constexpr T &emplace_back(Args &&...args) {
+            if (size() == N) throw runtime_error();
+            if constexpr (trivial) {
+                this->slots()[size()] = T(std::forward<Args>(args)...);
+            } else {
+                new(end()) T(std::forward<Args>(args)...);
+            }
+            return this->slots()[this->curLen++];
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        constexpr void pop_back() {
+            if (empty()) { throw container_is_empty(); }
+            truncate(size() - 1);
+        }
+
+        /**
+         * inserts at the front, shifting every element; linear.
+         * throw runtime_error if the vector is full
+         */
+        constexpr void push_front(const T &value) {
+            emplace(begin(), value);
+        }
+
+        constexpr void push_front(T &&value) {
+            emplace(begin(), std::move(value));
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        constexpr void pop_front() {
+            if (empty()) { throw container_is_empty(); }
+            erase(begin());
+        }
+
+    private:
+        static constexpr bool trivial = std::is_trivial<T>::value;
+        static constexpr bool relocatable = is_trivially_relocatable<T>::value;
+
+        // destroys the elements from n on.
+        constexpr void truncate(size_t n) {
+            if constexpr (!trivial) {
+                for (size_t i = n; i < size(); ++i) this->slots()[i].~T();
+            }
+            this->curLen = n;
+        }
+
+        /**
+         * inserts count elements at ind, each built by construct(dest) in the
+         * raw slot dest, in order. If a construction throws, the vector is left unchanged.
+         */
+        template<class Construct>
+        void insertElements(size_t ind, size_t count, Construct construct) {
+            size_t old = size();
+            if constexpr (relocatable) {
+                T *gap = begin() + ind;
+                std::memmove(static_cast<void *>(gap + count), gap, (old - ind) * sizeof(T));
+                size_t k = 0;
+                try {
+                    for (; k < count; ++k) construct(gap + k);
+                } catch (...) {
+                    for (size_t i = 0; i < k; ++i) gap[i].~T();
+                    std::memmove(static_cast<void *>(gap), gap + count, (old - ind) * sizeof(T));
+                    throw;
+                }
+                this->curLen += count;
+            } else {
+                // build at the end, where nothing has to move, then rotate into place.
+                try {
+                    for (size_t k = 0; k < count; ++k) {
+                        construct(end());
+                        ++this->curLen;
+                    }
+                } catch (...) {
+                    truncate(old);
+                    throw;
+                }
+                std::rotate(begin() + ind, begin() + old, end());
+            }
+        }
+    };
+
+    template<typename T, size_t N1, size_t N2>
+    constexpr bool operator==(const static_vector<T, N1> &lhs, const static_vector<T, N2> &rhs) {
+        if (lhs.size() != rhs.size()) return false;
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            if (!(lhs.data()[i] == rhs.data()[i])) return false;
+        }
+        return true;
+    }
+
+    template<typename T, size_t N1, size_t N2>
+    constexpr bool operator!=(const static_vector<T, N1> &lhs, const static_vector<T, N2> &rhs) {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef SJTU_TYPE_TRAITS_HPP
+#define SJTU_TYPE_TRAITS_HPP
+
+#include <type_traits>
+
+namespace sjtu {
+
+/**
+ * whether an object of type T may be moved to a new address by copying its
+ * bytes and then forgetting the original, instead of calling T's move
+ * constructor followed by its destructor.
+ *
+ * every trivially copyable type qualifies. Other types may opt in with a
+ * specialization, as long as no object holds a pointer into itself.
+ * A type that owns a heap buffer through a plain pointer, like Util::Bint, is fine:
+ *
+ *   namespace sjtu {
+ *       template<>
+ *       struct is_trivially_relocatable<Util::Bint> : std::true_type {};
+ *   }
+ */
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+struct is_trivially_relocatable<const T> : is_trivially_relocatable<T> {};
+
+/**
+ * T itself; a parameter written as type_identity_t<T> does not take part in
+ * template argument deduction, so fill(v, 0) works for a vector<double>.
+ * (std::type_identity only arrives with C++20.)
+ */
+template<typename T>
+struct type_identity {
+    using type = T;
+};
+
+template<typename T>
+using type_identity_t = typename type_identity<T>::type;
+
+}
+
+#endif
@@ -1,19 +1,105 @@
 #ifndef SJTU_VECTOR_HPP
 #define SJTU_VECTOR_HPP
 
+#include "allocator.hpp"
 #include "exceptions.hpp"
+#include "parallel.hpp"
+#include "serialize.hpp"
+#include "simd.hpp"
+#include "type_traits.hpp"
 
 #include <climits>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <new>
+#include <utility>
 
 namespace sjtu {
+/**
+ * growth policy of a vector, passed as its second template argument.
+ * grow(cap, need) returns the capacity to allocate once need > cap elements
+ * are required; shrink(cap, len) returns the capacity to keep after an erase.
+ *
+ * the buffer grows by a factor of Num / Den. It halves only once it is at most
+ * 1 / ShrinkDiv full, which leaves the halved buffer at most half full, so no
+ * push/pop sequence can bounce between growing and shrinking.
+ * ShrinkDiv == 0 never shrinks.
+ */
+    template<size_t Num = 2, size_t Den = 1, size_t ShrinkDiv = 4>
+    struct growth_policy {
+        static_assert(Num > Den, "growth factor must be greater than 1");
+        static_assert(ShrinkDiv == 0 || ShrinkDiv > 2, "shrink threshold must stay below half full");
+
+        static const size_t minCapacity = 10;
+
+        static size_t grow(size_t cap, size_t need) {
+            size_t n = cap / Den * Num + cap % Den * Num / Den;
+            if (n < minCapacity) n = minCapacity;
+            return n < need ? need : n;
+        }
+
+        static size_t shrink(size_t cap, size_t len) {
+            if (ShrinkDiv == 0 || cap <= minCapacity || len * ShrinkDiv > cap) return cap;
+            return cap / 2;
+        }
+    };
+
+    using default_growth = growth_policy<>;
+    using never_shrink = growth_policy<2, 1, 0>;
+
+/**
+ * the in-object buffer of a vector: room for N elements that are used before
+ * the vector first touches the heap. It is an empty base when N == 0, so a
+ * plain vector pays nothing for it.
+ */
+    template<typename T, size_t N>
+    struct vector_inline_storage {
+        alignas(T) unsigned char bytes[N * sizeof(T)];
+
+        T *inlineBuf() {
+            return reinterpret_cast<T *>(bytes);
+        }
+    };
+
+    template<typename T>
+    struct vector_inline_storage<T, 0> {
+        T *inlineBuf() {
+            return nullptr;
+        }
+    };
+
 /**
  * a data container like std::vector
  * store data in a successive memory and support random access.
+ *
+ * elements live inline in one raw buffer of maxSiz slots. The first frontGap
+ * slots are free, the next curLen hold constructed objects (buf points at the
+ * first of them) and the rest are free again. Objects are only ever created
+ * with placement-new, so T needs no default constructor.
+ *
+ * the free slots in front make the vector double-ended: pop_front and
+ * erasing at begin() just advance buf, and push_front reuses that room or
+ * grows with room on both sides, so both are amortized O(1). When one end
+ * runs out of room while the other still has some, the elements slide within
+ * the buffer instead, so capacity() elements always fit without reallocating.
+ *
+ * when sjtu::is_trivially_relocatable<T> holds, growing the buffer and shifting
+ * elements inside it are plain memcpy / memmove calls.
+ *
+ * the first N elements are kept inside the vector object itself and the heap is
+ * only used past N (see small_vector). With the default N == 0 the buffer starts
+ * out null, so an empty vector allocates nothing until its first insert.
+ *
+ * heap buffers come from Allocator (see allocator.hpp). The allocator travels
+ * with the contents: copies, moves, assignments and swaps carry it along.
+ *
+ * vector<bool> is specialized to pack its elements into bits; see vector_bool.hpp.
  */
-    template<typename T>
-    class vector {
+    template<typename T, class Growth = default_growth, size_t N = 0, class Allocator = allocator<T>>
+    class vector : private vector_inline_storage<T, N>, private Allocator {
     public:
         /**
          * TODO
@@ -42,7 +128,11 @@ namespace sjtu {
             using value_type = T;
             using pointer = T *;
             using reference = T &;
-            using iterator_category = std::output_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+            // elements are contiguous, so std::to_address turns an iterator into a raw pointer.
+            using iterator_concept = std::contiguous_iterator_tag;
+#endif
 
         private:
             /**
@@ -50,42 +140,40 @@ namespace sjtu {
              *   just add whatever you want.
              */
         public:
+            T *current;
+
+            iterator() : current(nullptr) {}
+
+            explicit iterator(T *p) : current(p) {}
+
             /**
              * return a new iterator which pointer n-next elements
              * as well as operator-
              */
-            T **current;
-
-            /*iterator operator=(const iterator &rhs) {
-                current = rhs.current;
-                return *this;
-            }*/
+            iterator operator+(difference_type n) const {
+                return iterator(current + n);
+            }
 
-            iterator operator+(const int &n) const {
-                iterator tmp = *this;
-                tmp.current = current + n;
-                return tmp;
+            friend iterator operator+(difference_type n, const iterator &it) {
+                return iterator(it.current + n);
             }
 
-            iterator operator-(const int &n) const {
-                iterator tmp = *this;
-                tmp.current = current - n;
-                return tmp;
+            iterator operator-(difference_type n) const {
+                return iterator(current - n);
             }
 
             // return the distance between two iterators,
             // if these two iterators point to different vectors, throw invaild_iterator.
-            int operator-(const iterator &rhs) const {
-                if (false) { throw invalid_iterator; }
-                return rhs.current - current;
+            difference_type operator-(const iterator &rhs) const {
+                return current - rhs.current;
             }
 
-            iterator &operator+=(const int &n) {
+            iterator &operator+=(difference_type n) {
                 current += n;
                 return *this;
             }
 
-            iterator &operator-=(const int &n) {
+            iterator &operator-=(difference_type n) {
                 current -= n;
                 return *this;
             }
@@ -113,7 +201,22 @@ namespace sjtu {
             }
 
             T &operator*() const {
-                return **current;
+                return *current;
+            }
+
+            T *operator->() const {
+                return current;
+            }
+
+            T &operator[](difference_type n) const {
+                return current[n];
+            }
+
+            /**
+             * returns the raw pointer to the element.
+             */
+            T *base() const {
+                return current;
             }
 
             /**
@@ -137,6 +240,38 @@ namespace sjtu {
             bool operator!=(const const_iterator &rhs) const {
                 return current != rhs.current;
             }
+
+            bool operator<(const iterator &rhs) const {
+                return current < rhs.current;
+            }
+
+            bool operator<(const const_iterator &rhs) const {
+                return current < rhs.current;
+            }
+
+            bool operator>(const iterator &rhs) const {
+                return current > rhs.current;
+            }
+
+            bool operator>(const const_iterator &rhs) const {
+                return current > rhs.current;
+            }
+
+            bool operator<=(const iterator &rhs) const {
+                return current <= rhs.current;
+            }
+
+            bool operator<=(const const_iterator &rhs) const {
+                return current <= rhs.current;
+            }
+
+            bool operator>=(const iterator &rhs) const {
+                return current >= rhs.current;
+            }
+
+            bool operator>=(const const_iterator &rhs) const {
+                return current >= rhs.current;
+            }
         };
 
         /**
@@ -147,43 +282,51 @@ namespace sjtu {
         public:
             using difference_type = std::ptrdiff_t;
             using value_type = T;
-            using pointer = T *;
-            using reference = T &;
-            using iterator_category = std::output_iterator_tag;
+            using pointer = const T *;
+            using reference = const T &;
+            using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+            using iterator_concept = std::contiguous_iterator_tag;
+#endif
 
         private:
         public:
-            T **current;
+            const T *current;
+
+            const_iterator() : current(nullptr) {}
+
+            explicit const_iterator(const T *p) : current(p) {}
+
+            const_iterator(const iterator &it) : current(it.current) {}
 
             /**
              * return a new iterator which pointer n-next elements
              * as well as operator-
              */
-            const_iterator operator+(const int &n) const {
-                const_iterator tmp = *this;
-                tmp.current = current + n;
-                return tmp;
+            const_iterator operator+(difference_type n) const {
+                return const_iterator(current + n);
             }
 
-            const_iterator operator-(const int &n) const {
-                const_iterator tmp = *this;
-                tmp.current = current - n;
-                return tmp;
+            friend const_iterator operator+(difference_type n, const const_iterator &it) {
+                return const_iterator(it.current + n);
+            }
+
+            const_iterator operator-(difference_type n) const {
+                return const_iterator(current - n);
             }
 
             // return the distance between two iterators,
             // if these two iterators point to different vectors, throw invaild_iterator.
-            int operator-(const const_iterator &rhs) const {
-                if (false) { throw invalid_iterator; }
-                return rhs.current - current;
+            difference_type operator-(const const_iterator &rhs) const {
+                return current - rhs.current;
             }
 
-            const_iterator &operator+=(const int &n) {
+            const_iterator &operator+=(difference_type n) {
                 current += n;
                 return *this;
             }
 
-            const_iterator &operator-=(const int &n) {
+            const_iterator &operator-=(difference_type n) {
                 current -= n;
                 return *this;
             }
@@ -200,8 +343,8 @@ namespace sjtu {
             }
 
             const_iterator operator--(int) {
-                iterator tmp = *this;
-                current++;
+                const_iterator tmp = *this;
+                current--;
                 return tmp;
             }
 
@@ -210,8 +353,20 @@ namespace sjtu {
                 return *this;
             }
 
-            T &operator*() const {
-                return **current;
+            const T &operator*() const {
+                return *current;
+            }
+
+            const T *operator->() const {
+                return current;
+            }
+
+            const T &operator[](difference_type n) const {
+                return current[n];
+            }
+
+            const T *base() const {
+                return current;
             }
 
             /**
@@ -236,54 +391,161 @@ namespace sjtu {
                 return current != rhs.current;
             }
 
+            bool operator<(const const_iterator &rhs) const {
+                return current < rhs.current;
+            }
+
+            bool operator>(const const_iterator &rhs) const {
+                return current > rhs.current;
+            }
+
+            bool operator<=(const const_iterator &rhs) const {
+                return current <= rhs.current;
+            }
+
+            bool operator>=(const const_iterator &rhs) const {
+                return current >= rhs.current;
+            }
         };
 
         /**
          * TODO Constructs
          * At least two: default constructor, copy constructor
          */
-        vector() : data(nullptr), maxSiz(10) {
-            curLen = 0;
-            data = new T *[maxSiz];
+        vector() : buf(this->inlineBuf()), curLen(0), maxSiz(N), frontGap(0) {}
 
-        }
+        /**
+         * an empty vector that will allocate through alloc, e.g. an arena_allocator.
+         */
+        explicit vector(const Allocator &alloc) : Allocator(alloc), buf(this->inlineBuf()), curLen(0), maxSiz(N), frontGap(0) {}
 
-        vector(const vector &other) {
-            curLen = 0;
-            maxSiz = other.maxSiz;
-            data = new T *[maxSiz];
-            for (const_iterator it = other.cbegin(); it != other.cend(); it++) {
-                push_back(*it);
+        vector(const vector &other)
+                : Allocator(other.allocRef()), buf(this->inlineBuf()), curLen(0), maxSiz(N), frontGap(0) {
+            if (other.curLen > N) {
+                buf = allocate(other.curLen);
+                maxSiz = other.curLen;
+            }
+            try {
+                uninitializedCopy(other.buf, other.buf + other.curLen, buf);
+            } catch (...) {
+                release();
+                throw;
             }
+            curLen = other.curLen;
+        }
+
+        /**
+         * copy constructor that splits the copy across threads; see parallel_t.
+         * T's copy constructor must be safe to run concurrently.
+         */
+        vector(parallel_t policy, const vector &other)
+                : Allocator(other.allocRef()), buf(this->inlineBuf()), curLen(0), maxSiz(N), frontGap(0) {
+            const T *src = other.buf;
+            buildParallel(policy, other.curLen, [src](T *dest, size_t from, size_t to) {
+                uninitializedCopy(src + from, src + to, dest + from);
+            });
+        }
+
+        /**
+         * constructs n copies of value, split across threads; see parallel_t.
+         */
+        vector(parallel_t policy, size_t n, const T &value)
+                : buf(this->inlineBuf()), curLen(0), maxSiz(N), frontGap(0) {
+            buildParallel(policy, n, [&value](T *dest, size_t from, size_t to) {
+                uninitializedFill(dest + from, to - from, value);
+            });
+        }
+
+        /**
+         * returns a vector of n elements where element i is constructed in place
+         * from gen(i). The calls are split across threads, so gen must be safe
+         * to call concurrently.
+         */
+        template<class Gen>
+        static vector generate(parallel_t policy, size_t n, Gen gen, const Allocator &alloc = Allocator()) {
+            vector result(alloc);
+            result.buildParallel(policy, n, [&gen](T *dest, size_t from, size_t to) {
+                size_t i = from;
+                try {
+                    for (; i < to; ++i) new(dest + i) T(gen(i));
+                } catch (...) {
+                    destroy(dest + from, dest + i);
+                    throw;
+                }
+            });
+            return result;
+        }
+
+        /**
+         * steals the buffer of other in O(1); other is left empty.
+         * elements still held in other's inline buffer are moved one by one.
+         */
+        vector(vector &&other) noexcept(nothrowMove)
+                : Allocator(other.allocRef()), buf(this->inlineBuf()), curLen(0), maxSiz(N), frontGap(0) {
+            takeFrom(other);
         }
 
         /**
          * TODO Destructor
          */
         ~vector() {
-            clear();
-            delete[] data;
-            data = nullptr;
+            destroy(buf, buf + curLen);
+            release();
+            buf = nullptr;
         }
 
         /**
          * TODO Assignment operator
          */
         vector &operator=(const vector &other) {
-            vector<T> tmp = vector<T>(other);
-            auto f1 = data;
-            data = tmp.data;
-            tmp.data = f1;
+            if (this == &other) return *this;
+            vector tmp = vector(other);
+            *this = std::move(tmp);
+            return *this;
+        }
+
+        vector &operator=(vector &&other) noexcept(nothrowMove) {
+            if (this == &other) return *this;
+            destroy(buf, buf + curLen);
+            release();
+            buf = this->inlineBuf();
+            curLen = 0;
+            maxSiz = N;
+            frontGap = 0;
+            takeFrom(other);
+            return *this;
+        }
+
+        /**
+         * exchanges the contents with other, in O(1) unless either side still
+         * uses its inline buffer.
+         */
+        void swap(vector &other) noexcept(nothrowMove) {
+            if (isSmall() || other.isSmall()) {
+                vector tmp = vector(std::move(other));
+                other = std::move(*this);
+                *this = std::move(tmp);
+                return;
+            }
+            Allocator f0 = allocRef();
+            allocRef() = other.allocRef();
+            other.allocRef() = f0;
+
+            auto f1 = buf;
+            buf = other.buf;
+            other.buf = f1;
 
             auto f2 = curLen;
-            curLen = tmp.curLen;
-            tmp.curLen = f2;
+            curLen = other.curLen;
+            other.curLen = f2;
 
             auto f3 = maxSiz;
-            maxSiz = tmp.maxSiz;
-            tmp.maxSiz = f3;
+            maxSiz = other.maxSiz;
+            other.maxSiz = f3;
 
-            return *this;
+            auto f4 = frontGap;
+            frontGap = other.frontGap;
+            other.frontGap = f4;
         }
 
         /**
@@ -291,12 +553,13 @@ namespace sjtu {
          * throw index_out_of_bound if pos is not in [0, size)
          */
         T &at(const size_t &pos) {
-            if (pos >= size() || pos < 0) { throw index_out_of_bound; }
-            return *(begin() + pos);
+            if (pos >= size()) { throw index_out_of_bound(); }
+            return buf[pos];
         }
 
         const T &at(const size_t &pos) const {
-            return *(cbegin() + pos);
+            if (pos >= size()) { throw index_out_of_bound(); }
+            return buf[pos];
         }
 
         /**
@@ -318,8 +581,8 @@ namespace sjtu {
          * throw container_is_empty if size == 0
          */
         const T &front() const {
-            if (empty()) { throw container_is_empty; }
-            return *(cbegin());
+            if (empty()) { throw container_is_empty(); }
+            return buf[0];
         }
 
         /**
@@ -327,38 +590,49 @@ namespace sjtu {
          * throw container_is_empty if size == 0
          */
         const T &back() const {
-            if (empty()) {}
-            return *(cend() - 1);
+            if (empty()) { throw container_is_empty(); }
+            return buf[curLen - 1];
         }
 
         /**
          * returns an iterator to the beginning.
          */
         iterator begin() {
-            iterator tmp;
-            tmp.current = data;
-            return tmp;
+            return iterator(buf);
+        }
+
+        const_iterator begin() const {
+            return const_iterator(buf);
         }
 
         const_iterator cbegin() const {
-            const_iterator tmp;
-            tmp.current = data;
-            return tmp;
+            return const_iterator(buf);
         }
 
         /**
          * returns an iterator to the end.
          */
         iterator end() {
-            iterator tmp;
-            tmp.current = data + curLen;
-            return tmp;
+            return iterator(buf + curLen);
+        }
+
+        const_iterator end() const {
+            return const_iterator(buf + curLen);
         }
 
         const_iterator cend() const {
-            const_iterator tmp;
-            tmp.current = data + curLen;
-            return tmp;
+            return const_iterator(buf + curLen);
+        }
+
+        /**
+         * returns the underlying buffer; [data(), data() + size()) are the elements.
+         */
+        T *data() {
+            return buf;
+        }
+
+        const T *data() const {
+            return buf;
         }
 
         /**
@@ -372,18 +646,46 @@ namespace sjtu {
          * returns the number of elements
          */
         size_t size() const {
-            size_t tmp;
-            tmp = curLen;
-            return tmp;
+            return curLen;
+        }
+
+        Allocator get_allocator() const {
+            return allocRef();
+        }
+
+        /**
+         * returns the number of elements the vector can hold before it has to reallocate.
+         */
+        size_t capacity() const {
+            return maxSiz;
+        }
+
+        /**
+         * makes room for at least n elements with a single allocation.
+         * does nothing if the capacity is already n or more.
+         * later erases may still shrink the buffer unless Growth never shrinks.
+         */
+        void reserve(size_t n) {
+            if (n > capacity()) relocate(n);
+        }
+
+        /**
+         * releases unused capacity so that capacity() == size().
+         */
+        void shrink_to_fit() {
+            if (maxSiz == curLen) return;
+            relocate(curLen);
         }
 
         /**
          * clears the contents
+         * destroys every element in one pass and keeps the buffer for reuse.
          */
         void clear() {
-            while (!empty()) {
-                pop_back();
-            }
+            destroy(buf, buf + curLen);
+            buf -= frontGap;
+            frontGap = 0;
+            curLen = 0;
         }
 
         /**
@@ -391,18 +693,67 @@ namespace sjtu {
          * returns an iterator pointing to the inserted value.
          */
         iterator insert(iterator pos, const T &value) {
-            iterator it, it2;
-            it = end();
-            it2 = end() - 1;
-            while (it != pos) {
-                *(it.current) = *(it2.current);
-                it--;
-                it2--;
-            }
-            *(it.current) = new T(value);
+            return emplace(pos, value);
+        }
+
+        iterator insert(iterator pos, T &&value) {
+            return emplace(pos, std::move(value));
+        }
+
+        /**
+         * constructs an element from args directly before pos.
+         * returns an iterator pointing to the new element.
+         */
+        template<typename... Args>
+        iterator emplace(iterator pos, Args &&...args) {
+            size_t ind = pos.current - buf;
+            if (ind == 0 && frontGap != 0) {
+                new(buf - 1) T(std::forward<Args>(args)...);
+                --buf;
+                --frontGap;
+                curLen++;
+                return begin();
+            }
+            // with no room in front, shifting every element for each front insertion
+            // would be quadratic. A heap buffer with room behind the elements moves
+            // them to the middle of it, and a full one is regrown with room on both sides.
+            bool front = ind == 0 && curLen != 0 && !isSmall();
+            if (curLen < maxSiz && (front || curLen + frontGap == maxSiz)) {
+                // the room is on the wrong side; args may refer to an element, so
+                // the new one is built before the elements move.
+                T tmp(std::forward<Args>(args)...);
+                if (front) {
+                    openFrontGap();
+                } else {
+                    closeFrontGap();
+                }
+                return emplace(begin() + ind, std::move(tmp));
+            }
+            if (curLen == maxSiz) {
+                // args may refer to an element of this vector, so the new
+                // element is built in the new buffer before the old one is released.
+                expandSpace(ind, 1, [&](T *dest) { new(dest) T(std::forward<Args>(args)...); }, front);
+                return begin() + ind;
+            }
+            if (ind == curLen) {
+                new(buf + curLen) T(std::forward<Args>(args)...);
+            } else if constexpr (relocatable) {
+                // build the element aside first so that a throwing constructor
+                // leaves the vector untouched; past that point nothing can throw.
+                alignas(T) unsigned char tmp[sizeof(T)];
+                new(tmp) T(std::forward<Args>(args)...);
+                std::memmove(static_cast<void *>(buf + ind + 1), buf + ind, (curLen - ind) * sizeof(T));
+                std::memcpy(static_cast<void *>(buf + ind), tmp, sizeof(T));
+            } else {
+                T tmp(std::forward<Args>(args)...);
+                new(buf + curLen) T(std::move(buf[curLen - 1]));
+                for (size_t i = curLen - 1; i > ind; --i) {
+                    buf[i] = std::move(buf[i - 1]);
+                }
+                buf[ind] = std::move(tmp);
+            }
             curLen++;
-            if (maxSiz == curLen + 1) expandSpace();
-            return it;
+            return begin() + ind;
         }
 
         /**
@@ -416,25 +767,85 @@ namespace sjtu {
             return insert(begin() + ind, value);
         }
 
+        /**
+         * inserts count copies of value before pos.
+         * the tail is shifted once and the buffer grows at most once.
+         * returns an iterator pointing to the first inserted element (pos if count == 0).
+         */
+        iterator insert(iterator pos, size_t count, const T &value) {
+            size_t ind = pos.current - buf;
+            if (count == 0) return pos;
+            if (curLen + count > maxSiz) {
+                expandSpace(ind, count, [&](T *dest) { uninitializedFill(dest, count, value); });
+                return begin() + ind;
+            }
+            // value may be an element that the shift is about to move.
+            T tmp(value);
+            if (curLen + frontGap + count > maxSiz) closeFrontGap();
+            insertGap(ind, count, [&](T *dest) { uninitializedFill(dest, count, tmp); });
+            return begin() + ind;
+        }
+
+        /**
+         * inserts a copy of [first, last) before pos.
+         * first and last must be forward iterators that do not point into this vector.
+         * the tail is shifted once and the buffer grows at most once.
+         * returns an iterator pointing to the first inserted element (pos if the range is empty).
+         */
+        template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        iterator insert(iterator pos, InputIt first, InputIt last) {
+            size_t ind = pos.current - buf;
+            size_t count = distance(first, last);
+            if (count == 0) return pos;
+            if (curLen + count > maxSiz) {
+                expandSpace(ind, count, [&](T *dest) { uninitializedCopyRange(first, last, dest); });
+            } else {
+                if (curLen + frontGap + count > maxSiz) closeFrontGap();
+                insertGap(ind, count, [&](T *dest) { uninitializedCopyRange(first, last, dest); });
+            }
+            return begin() + ind;
+        }
+
+        /**
+         * replaces the contents with a copy of [first, last).
+         * first and last must be forward iterators that do not point into this vector.
+         * allocates only if the current capacity is too small.
+         */
+        template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        void assign(InputIt first, InputIt last) {
+            size_t count = distance(first, last);
+            clear();
+            if (count > maxSiz) {
+                size_t n = Growth::grow(0, count);
+                T *tmp = allocate(n);
+                release();
+                buf = tmp;
+                maxSiz = n;
+            }
+            uninitializedCopyRange(first, last, buf);
+            curLen = count;
+        }
+
         /**
          * removes the element at pos.
          * return an iterator pointing to the following element.
          * If the iterator pos refers the last element, the end() iterator is returned.
          */
         iterator erase(iterator pos) {
-            delete *(pos.current);
-            iterator it, it2;
-            it = pos;
-            it2 = pos + 1;
-            while (it != end() - 1) {
-                *(it.current) = *(it2.current);
-                it++;
-                it2++;
-            }
-            it2.current = nullptr;
+            size_t ind = pos.current - buf;
+            if (ind == 0) return erase(pos, pos + 1);
+            if constexpr (relocatable) {
+                buf[ind].~T();
+                std::memmove(static_cast<void *>(buf + ind), buf + ind + 1, (curLen - ind - 1) * sizeof(T));
+            } else {
+                for (size_t i = ind; i + 1 < curLen; ++i) {
+                    buf[i] = std::move(buf[i + 1]);
+                }
+                buf[curLen - 1].~T();
+            }
             curLen--;
-            if (maxSiz == curLen * 4) reduceSpace();
-            return pos;
+            reduceSpace();
+            return begin() + ind;
         }
 
         /**
@@ -443,15 +854,98 @@ namespace sjtu {
          * throw index_out_of_bound if ind >= size
          */
         iterator erase(const size_t &ind) {
-            if (ind >= size()) throw index_out_of_bound;
+            if (ind >= size()) throw index_out_of_bound();
             return erase(begin() + ind);
         }
 
+        /**
+         * keeps only the elements for which keep(element) is true, preserving
+         * their order. Survivors are compacted in one pass and the buffer
+         * shrinks at most once, at the end.
+         * returns the number of elements removed.
+         * if keep throws, the elements not yet visited are kept.
+         */
+        template<class Pred>
+        size_t retain(Pred keep) {
+            size_t w = 0, r = 0;
+            try {
+                for (; r < curLen; ++r) {
+                    if (keep(buf[r])) {
+                        if (w != r) {
+                            if constexpr (relocatable) {
+                                std::memcpy(static_cast<void *>(buf + w), buf + r, sizeof(T));
+                            } else {
+                                buf[w] = std::move(buf[r]);
+                            }
+                        }
+                        ++w;
+                    } else if constexpr (relocatable) {
+                        buf[r].~T();
+                    }
+                }
+            } catch (...) {
+                // close the hole [w, r) left by the removed elements.
+                if (w != r) closeHole(w, r);
+                throw;
+            }
+            size_t removed = curLen - w;
+            if constexpr (!relocatable) destroy(buf + w, buf + curLen);
+            curLen = w;
+            reduceSpace();
+            return removed;
+        }
+
+        /**
+         * removes the elements in [first, last).
+         * the tail is shifted once and the buffer shrinks at most once.
+         * return an iterator pointing to the element that followed the removed range.
+         */
+        iterator erase(iterator first, iterator last) {
+            size_t ind = first.current - buf;
+            size_t count = last.current - first.current;
+            if (count == 0) return first;
+            if (ind == 0) {
+                // nothing needs to move: the erased slots join the front gap.
+                destroy(buf, buf + count);
+                buf += count;
+                frontGap += count;
+            } else if constexpr (relocatable) {
+                destroy(buf + ind, buf + ind + count);
+                std::memmove(static_cast<void *>(buf + ind), buf + ind + count,
+                             (curLen - ind - count) * sizeof(T));
+            } else {
+                for (size_t i = ind; i + count < curLen; ++i) {
+                    buf[i] = std::move(buf[i + count]);
+                }
+                destroy(buf + curLen - count, buf + curLen);
+            }
+            curLen -= count;
+            if (curLen == 0) {
+                buf -= frontGap;
+                frontGap = 0;
+            }
+            reduceSpace();
+            return begin() + ind;
+        }
+
         /**
          * adds an element to the end.
          */
         void push_back(const T &value) {
-            insert(end(), value);
+            emplace(end(), value);
+        }
+
+        void push_back(T &&value) {
+            emplace(end(), std::move(value));
+        }
+
+        /**
+         * constructs an element in place at the end.
+         * returns a reference to the new element.
+         */
+        template<typename... Args>
+        T &emplace_back(Args &&...args) {
+            return *emplace(end(), std::forward<Args>(args)...);
         }
 
         /**
@@ -463,31 +957,512 @@ namespace sjtu {
             erase(end() - 1);
         }
 
+        /**
+         * adds an element to the beginning in amortized O(1).
+         */
+        void push_front(const T &value) {
+            emplace(begin(), value);
+        }
+
+        void push_front(T &&value) {
+            emplace(begin(), std::move(value));
+        }
+
+        template<typename... Args>
+        T &emplace_front(Args &&...args) {
+            return *emplace(begin(), std::forward<Args>(args)...);
+        }
+
+        /**
+         * removes the first element in O(1), apart from a possible shrink.
+         * throw container_is_empty if size() == 0
+         */
+        void pop_front() {
+            if (empty()) { throw container_is_empty(); }
+            erase(begin(), begin() + 1);
+        }
+
+        /**
+         * writes a binary snapshot of the elements to os; see serialize.hpp.
+         * trivially copyable elements are written as one block of bytes.
+         * throw runtime_error if os fails.
+         */
+        void save(std::ostream &os) const {
+            snapshot_header('V', 0, snapshot_size<T>(), curLen).save(os);
+            if constexpr (is_raw_serializable<T>::value) {
+                write_bytes(os, buf, curLen * sizeof(T));
+            } else {
+                for (size_t i = 0; i < curLen; ++i) serializer<T>::save(os, buf[i]);
+            }
+        }
+
+        /**
+         * replaces the elements with those of a snapshot written by save.
+         * throw runtime_error if is does not hold such a snapshot of T or ends
+         * early; the vector is left unchanged then.
+         */
+        void load(std::istream &is) {
+            size_t n = snapshot_count(is, snapshot_header::load(is, snapshot_header('V', 0, snapshot_size<T>(), 0)),
+                                      snapshot_size<T>());
+            vector tmp(allocRef());
+            if constexpr (is_raw_serializable<T>::value) {
+                // n has been checked against is only if it can seek; otherwise the
+                // block is read in runs that at most double the buffer, so a short
+                // stream fails before much is allocated.
+                if (bytes_left(is) != size_t(-1)) tmp.reserve(n);
+                while (tmp.curLen < n) {
+                    size_t run = n - tmp.curLen;
+                    size_t most = tmp.curLen > loadRun ? tmp.curLen : loadRun;
+                    if (run > most) run = most;
+                    tmp.reserve(tmp.curLen + run);
+                    read_bytes(is, tmp.buf + tmp.curLen, run * sizeof(T));
+                    tmp.curLen += run;
+                }
+            } else {
+                for (size_t i = 0; i < n; ++i) tmp.emplace_back(serializer<T>::load(is));
+            }
+            *this = std::move(tmp);
+        }
+
     private:
-        T **data;
-        int curLen;
-        int maxSiz;
-
-        void expandSpace() {
-            T **tmp = new T *[maxSiz * 2];
-            for (auto it = data; it != end().current; it++) {
-                tmp[it - data] = *it;
-            }
-            maxSiz *= 2;
-            delete[] data;
-            data = tmp;
-        };
+        T *buf;
+        size_t curLen;
+        size_t maxSiz;
+        size_t frontGap;
+
+        static constexpr bool relocatable = is_trivially_relocatable<T>::value;
+        // the elements load reads at least at once from a stream that cannot seek.
+        static constexpr size_t loadRun = 4096;
+        static constexpr bool nothrowMove = N == 0 || std::is_nothrow_move_constructible<T>::value;
+
+        // the start of the allocated block, frontGap slots before buf.
+        T *block() {
+            return buf - frontGap;
+        }
 
-        void reduceSpace() {
-            T **tmp = new T *[maxSiz / 2];
-            for (auto it = data; it != end().current; it++) {
-                tmp[it - data] = *it;
+        bool isSmall() {
+            return N != 0 && block() == this->inlineBuf();
+        }
+
+        // frees the buffer unless it is the inline one.
+        void release() {
+            if (block() != this->inlineBuf()) deallocate(block(), maxSiz);
+        }
+
+        Allocator &allocRef() {
+            return *this;
+        }
+
+        const Allocator &allocRef() const {
+            return *this;
+        }
+
+        // moves the contents of other into *this, which must be empty and inline.
+        void takeFrom(vector &other) {
+            allocRef() = other.allocRef();
+            if (other.isSmall()) {
+                relocateRange(other.buf, other.buf + other.curLen, buf);
+                curLen = other.curLen;
+                other.buf = other.inlineBuf();
+                other.curLen = 0;
+                other.frontGap = 0;
+                return;
+            }
+            buf = other.buf;
+            curLen = other.curLen;
+            maxSiz = other.maxSiz;
+            frontGap = other.frontGap;
+            other.buf = other.inlineBuf();
+            other.curLen = 0;
+            other.maxSiz = N;
+            other.frontGap = 0;
+        }
+
+        T *allocate(size_t n) {
+            return allocRef().allocate(n);
+        }
+
+        void deallocate(T *p, size_t n) {
+            allocRef().deallocate(p, n);
+        }
+
+        static void destroy(T *first, T *last) {
+            if constexpr (std::is_trivially_destructible<T>::value) return;
+            for (; first != last; ++first) first->~T();
+        }
+
+        /**
+         * copy-constructs [first, last) into the raw memory at dest.
+         * if a constructor throws, the copies made so far are destroyed.
+         */
+        static T *uninitializedCopy(const T *first, const T *last, T *dest) {
+            if constexpr (std::is_trivially_copyable<T>::value) {
+                if (first != last) std::memcpy(static_cast<void *>(dest), first, (last - first) * sizeof(T));
+                return dest + (last - first);
+            }
+            T *cur = dest;
+            try {
+                for (; first != last; ++first, ++cur) new(cur) T(*first);
+            } catch (...) {
+                destroy(dest, cur);
+                throw;
             }
-            maxSiz /= 2;
-            delete[] data;
-            data = tmp;
+            return cur;
         }
+
+        /**
+         * copy-constructs the range [first, last) of any iterator type into the raw memory at dest.
+         * if a constructor throws, the copies made so far are destroyed.
+         */
+        template<typename InputIt>
+        static T *uninitializedCopyRange(InputIt first, InputIt last, T *dest) {
+            T *cur = dest;
+            try {
+                for (; first != last; ++first, ++cur) new(cur) T(*first);
+            } catch (...) {
+                destroy(dest, cur);
+                throw;
+            }
+            return cur;
+        }
+
+        static void uninitializedFill(T *dest, size_t count, const T &value) {
+            size_t i = 0;
+            try {
+                for (; i < count; ++i) new(dest + i) T(value);
+            } catch (...) {
+                destroy(dest, dest + i);
+                throw;
+            }
+        }
+
+        template<typename InputIt>
+        static size_t distance(InputIt first, InputIt last) {
+            size_t n = 0;
+            for (; first != last; ++first) ++n;
+            return n;
+        }
+
+        /**
+         * relocates [first, last) into the raw memory at dest, moving when T's
+         * move constructor cannot throw and copying otherwise, so a throw
+         * leaves the source untouched.
+         */
+        static T *uninitializedMove(T *first, T *last, T *dest) {
+            T *cur = dest;
+            try {
+                for (; first != last; ++first, ++cur) new(cur) T(std::move_if_noexcept(*first));
+            } catch (...) {
+                destroy(dest, cur);
+                throw;
+            }
+            return cur;
+        }
+
+        /**
+         * moves [first, last) into the raw memory at dest and ends the lifetime of
+         * the source objects. If this throws, the source is left untouched.
+         */
+        static void relocateRange(T *first, T *last, T *dest) {
+            if constexpr (relocatable) {
+                if (first != last) std::memcpy(static_cast<void *>(dest), first, (last - first) * sizeof(T));
+            } else {
+                uninitializedMove(first, last, dest);
+                destroy(first, last);
+            }
+        }
+
+        /**
+         * moves every element into a buffer of n slots and releases the old one.
+         * n <= N selects the inline buffer, which holds N slots; if that is the
+         * buffer in use, its front gap is closed instead.
+         */
+        void relocate(size_t n) {
+            T *tmp = n <= N ? this->inlineBuf() : allocate(n);
+            if (tmp == block()) {
+                if (frontGap != 0) closeFrontGap();
+                return;
+            }
+            try {
+                relocateRange(buf, buf + curLen, tmp);
+            } catch (...) {
+                if (n > N) deallocate(tmp, n);
+                throw;
+            }
+            release();
+            buf = tmp;
+            maxSiz = n <= N ? N : n;
+            frontGap = 0;
+        }
+
+        /**
+         * moves the tail [ind, curLen) up by count slots, leaving [ind, ind + count)
+         * as raw memory, then lets construct(buf + ind) fill it with count elements.
+         * capacity must already suffice. If anything throws, the tail is moved back.
+         */
+        template<typename Construct>
+        void insertGap(size_t ind, size_t count, Construct construct) {
+            if constexpr (relocatable) {
+                std::memmove(static_cast<void *>(buf + ind + count), buf + ind, (curLen - ind) * sizeof(T));
+            } else {
+                // walking backwards, every destination slot is already vacated.
+                size_t i = curLen;
+                try {
+                    for (; i > ind; --i) {
+                        new(buf + i - 1 + count) T(std::move_if_noexcept(buf[i - 1]));
+                        buf[i - 1].~T();
+                    }
+                } catch (...) {
+                    closeGap(i, count);
+                    throw;
+                }
+            }
+            try {
+                construct(buf + ind);
+            } catch (...) {
+                closeGap(ind, count);
+                throw;
+            }
+            curLen += count;
+        }
+
+        // undoes insertGap: moves [ind + count, curLen + count) back down to ind.
+        void closeGap(size_t ind, size_t count) {
+            if constexpr (relocatable) {
+                std::memmove(static_cast<void *>(buf + ind), buf + ind + count, (curLen - ind) * sizeof(T));
+            } else {
+                for (size_t i = ind; i < curLen; ++i) {
+                    new(buf + i) T(std::move_if_noexcept(buf[i + count]));
+                    buf[i + count].~T();
+                }
+            }
+        }
+
+        /**
+         * grows the buffer so that count more elements fit, letting
+         * construct(tmp + ind) build them in the new buffer, then moves the old
+         * elements around them. Growing for a front insertion leaves half of
+         * the spare room in front, so a run of push_front stays amortized O(1).
+         */
+        template<typename Construct>
+        void expandSpace(size_t ind, size_t count, Construct construct, bool front = false) {
+            size_t n = Growth::grow(maxSiz, curLen + count);
+            size_t gap = front ? (n - curLen - count + 1) / 2 : 0;
+            T *raw = allocate(n);
+            T *tmp = raw + gap;
+            try {
+                construct(tmp + ind);
+            } catch (...) {
+                deallocate(raw, n);
+                throw;
+            }
+            if constexpr (relocatable) {
+                relocateRange(buf, buf + ind, tmp);
+                relocateRange(buf + ind, buf + curLen, tmp + ind + count);
+            } else {
+                try {
+                    uninitializedMove(buf, buf + ind, tmp);
+                    try {
+                        uninitializedMove(buf + ind, buf + curLen, tmp + ind + count);
+                    } catch (...) {
+                        destroy(tmp, tmp + ind);
+                        throw;
+                    }
+                } catch (...) {
+                    destroy(tmp + ind, tmp + ind + count);
+                    deallocate(raw, n);
+                    throw;
+                }
+                destroy(buf, buf + curLen);
+            }
+            release();
+            buf = tmp;
+            maxSiz = n;
+            frontGap = gap;
+            curLen += count;
+        }
+
+        /**
+         * moves the elements up by half of the free slots behind them, which
+         * become the front gap; frontGap must be 0. If a move throws, the
+         * elements are moved back.
+         */
+        void openFrontGap() {
+            size_t gap = (maxSiz - curLen + 1) / 2;
+            insertGap(0, gap, [](T *) {});
+            curLen -= gap;
+            buf += gap;
+            frontGap = gap;
+        }
+
+        // moves the elements down to the start of the block, which ends the front gap.
+        void closeFrontGap() {
+            T *dest = block();
+            if constexpr (relocatable) {
+                std::memmove(static_cast<void *>(dest), buf, curLen * sizeof(T));
+            } else {
+                // the first slots of the gap are raw, the rest still hold elements.
+                size_t raw = frontGap < curLen ? frontGap : curLen;
+                uninitializedMove(buf, buf + raw, dest);
+                for (size_t i = raw; i < curLen; ++i) dest[i] = std::move(buf[i]);
+                destroy(buf + curLen - raw, buf + curLen);
+            }
+            buf = dest;
+            frontGap = 0;
+        }
+
+        // moves [r, curLen) down to w during retain; slots [w, r) are raw when relocatable.
+        void closeHole(size_t w, size_t r) {
+            if constexpr (relocatable) {
+                std::memmove(static_cast<void *>(buf + w), buf + r, (curLen - r) * sizeof(T));
+            } else {
+                for (size_t i = r; i < curLen; ++i) buf[w + i - r] = std::move(buf[i]);
+                destroy(buf + curLen - (r - w), buf + curLen);
+            }
+            curLen -= r - w;
+        }
+
+        /**
+         * constructs n elements in this empty vector with a buffer of exactly n
+         * slots. build(dest, from, to) must construct the elements [from, to)
+         * at dest + from, or none of them if it throws.
+         */
+        template<class Build>
+        void buildParallel(const parallel_t &policy, size_t n, Build build) {
+            if (n > N) {
+                buf = allocate(n);
+                maxSiz = n;
+            }
+            size_t k = policy.chunks(n);
+            T *dest = buf;
+            try {
+                parallel_t::run(k, [&](size_t c) {
+                    build(dest, parallel_t::begin(n, k, c), parallel_t::begin(n, k, c + 1));
+                }, [&](size_t c) {
+                    destroy(dest + parallel_t::begin(n, k, c), dest + parallel_t::begin(n, k, c + 1));
+                });
+            } catch (...) {
+                release();
+                buf = this->inlineBuf();
+                maxSiz = N;
+                throw;
+            }
+            curLen = n;
+        }
+
+        // applies the shrink policy as often as it allows, but reallocates only once.
+        void reduceSpace() {
+            size_t n = maxSiz, m;
+            while ((m = Growth::shrink(n, curLen)) < n) n = m;
+            if (n < maxSiz) relocate(n);
+        }
+    };
+
+    /**
+     * removes every element of v for which pred(element) is true, in a single
+     * linear pass; see vector::retain.
+     * returns the number of elements removed.
+     */
+    template<typename T, class Growth, size_t N, class Allocator, class Pred>
+    size_t erase_if(vector<T, Growth, N, Allocator> &v, Pred pred) {
+        return v.retain([&pred](T &x) { return !pred(x); });
+    }
+
+    /**
+     * returns an iterator to the first element of v equal to value, or v.end().
+     * vectorized for arithmetic T; see simd.hpp. T is taken from v alone, so
+     * value may be of any type that converts to it, here and in count and fill.
+     */
+    template<typename T, class Growth, size_t N, class Allocator>
+    typename vector<T, Growth, N, Allocator>::iterator find(vector<T, Growth, N, Allocator> &v, const type_identity_t<T> &value) {
+        const T *p = simd::find<T>(v.data(), v.data() + v.size(), value);
+        return v.begin() + (p - v.data());
     }
+
+    template<typename T, class Growth, size_t N, class Allocator>
+    typename vector<T, Growth, N, Allocator>::const_iterator find(const vector<T, Growth, N, Allocator> &v, const type_identity_t<T> &value) {
+        const T *p = simd::find<T>(v.data(), v.data() + v.size(), value);
+        return v.cbegin() + (p - v.data());
+    }
+
+    /**
+     * returns the number of elements of v equal to value.
+     */
+    template<typename T, class Growth, size_t N, class Allocator>
+    size_t count(const vector<T, Growth, N, Allocator> &v, const type_identity_t<T> &value) {
+        return simd::count<T>(v.data(), v.data() + v.size(), value);
+    }
+
+    /**
+     * returns an iterator to the first smallest element of v, or v.end() if v is empty.
+     */
+    template<typename T, class Growth, size_t N, class Allocator>
+    typename vector<T, Growth, N, Allocator>::iterator min_element(vector<T, Growth, N, Allocator> &v) {
+        const T *p = simd::min_element<T>(v.data(), v.data() + v.size());
+        return v.begin() + (p - v.data());
+    }
+
+    template<typename T, class Growth, size_t N, class Allocator>
+    typename vector<T, Growth, N, Allocator>::const_iterator min_element(const vector<T, Growth, N, Allocator> &v) {
+        const T *p = simd::min_element<T>(v.data(), v.data() + v.size());
+        return v.cbegin() + (p - v.data());
+    }
+
+    /**
+     * assigns value to every element of v.
+     */
+    template<typename T, class Growth, size_t N, class Allocator>
+    void fill(vector<T, Growth, N, Allocator> &v, const type_identity_t<T> &value) {
+        simd::fill<T>(v.data(), v.data() + v.size(), value);
+    }
+
+    /**
+     * assigns value to every element of v, split across threads; see parallel_t.
+     */
+    template<typename T, class Growth, size_t N, class Allocator>
+    void fill(parallel_t policy, vector<T, Growth, N, Allocator> &v, const type_identity_t<T> &value) {
+        T *p = v.data();
+        size_t n = v.size(), k = policy.chunks(n);
+        parallel_t::run(k, [&](size_t c) {
+            simd::fill<T>(p + parallel_t::begin(n, k, c), p + parallel_t::begin(n, k, c + 1), value);
+        }, [](size_t) {});
+    }
+
+    /**
+     * returns the vector of f(x) for every element x of v, built in place and
+     * split across threads; see parallel_t. f must be safe to call concurrently.
+     */
+    template<typename T, class Growth, size_t N, class Allocator, class F>
+    auto transform(parallel_t policy, const vector<T, Growth, N, Allocator> &v, F f)
+            -> vector<typename std::decay<decltype(f(v.data()[0]))>::type> {
+        const T *p = v.data();
+        using R = typename std::decay<decltype(f(v.data()[0]))>::type;
+        return vector<R>::generate(policy, v.size(), [p, &f](size_t i) { return f(p[i]); });
+    }
+
+    /**
+     * element-wise comparison; vectors with different growth policies,
+     * inline capacities or allocators compare by contents alone.
+     */
+    template<typename T, class G1, size_t N1, class A1, class G2, size_t N2, class A2>
+    bool operator==(const vector<T, G1, N1, A1> &lhs, const vector<T, G2, N2, A2> &rhs) {
+        return lhs.size() == rhs.size() && simd::equal<T>(lhs.data(), rhs.data(), lhs.size());
+    }
+
+    template<typename T, class G1, size_t N1, class A1, class G2, size_t N2, class A2>
+    bool operator!=(const vector<T, G1, N1, A1> &lhs, const vector<T, G2, N2, A2> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * a vector that keeps its first N elements inside the object and only
+     * allocates once it grows past N.
+     */
+    template<typename T, size_t N, class Growth = default_growth, class Allocator = allocator<T>>
+    using small_vector = vector<T, Growth, N, Allocator>;
 }
 
-#endif
\ No newline at end of file
+// the bit-packed vector<bool>, a specialization of the template above.
+#include "vector_bool.hpp"
+
+#endif
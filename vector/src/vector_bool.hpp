@@ -0,0 +1,915 @@
+#ifndef SJTU_VECTOR_BOOL_HPP
+#define SJTU_VECTOR_BOOL_HPP
+
+#include "vector.hpp"
+
+namespace sjtu {
+/**
+ * vector<bool> packs its elements into 64-bit words, one bit each, so n flags
+ * take n / 8 bytes instead of n.
+ *
+ * single bits are not addressable: at, operator[] and iterators yield a proxy
+ * reference that reads and writes one bit, front / back return plain bools and
+ * data() returns the words. Every bit past size() is kept zero, so count,
+ * find_first, set, reset, flip and comparisons work a whole word at a time,
+ * and count uses the population count kernel of simd.hpp.
+ *
+ * the first N bits (rounded up to whole words) live inside the object as in
+ * small_vector. There is no room in front: push_front and pop_front shift
+ * every word, which is linear but 64 elements per step. The parallel
+ * operations of the primary template are not offered.
+ */
+    template<class Growth, size_t N, class Allocator>
+    class vector<bool, Growth, N, Allocator>
+            : private vector_inline_storage<std::uint64_t, (N + 63) / 64>,
+              private rebind_allocator<Allocator, std::uint64_t>::type {
+        using word = std::uint64_t;
+        using word_allocator = typename rebind_allocator<Allocator, word>::type;
+
+        static constexpr size_t wordBits = 64;
+        static constexpr size_t inlineWords = (N + wordBits - 1) / wordBits;
+        static constexpr size_t inlineBits = inlineWords * wordBits;
+        // the words load reads at least at once from a stream that cannot seek.
+        static constexpr size_t loadRun = 512;
+
+    public:
+        /**
+         * stands for one bit of the vector; converts to bool and assigns from it.
+         */
+        class reference {
+        public:
+            reference(word *bits, size_t pos) : w(bits + pos / wordBits), m(word(1) << pos % wordBits) {}
+
+            reference(const reference &) = default;
+
+            operator bool() const {
+                return (*w & m) != 0;
+            }
+
+            reference &operator=(bool value) {
+                if (value) {
+                    *w |= m;
+                } else {
+                    *w &= ~m;
+                }
+                return *this;
+            }
+
+            reference &operator=(const reference &other) {
+                return *this = bool(other);
+            }
+
+            bool operator~() const {
+                return (*w & m) == 0;
+            }
+
+            void flip() {
+                *w ^= m;
+            }
+
+            friend void swap(reference a, reference b) {
+                bool t = a;
+                a = bool(b);
+                b = t;
+            }
+
+        private:
+            word *w;
+            word m;
+        };
+
+        using const_reference = bool;
+
+        class const_iterator;
+
+        class iterator {
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = bool;
+            using pointer = void;
+            using reference = typename vector::reference;
+            using iterator_category = std::random_access_iterator_tag;
+
+            word *bits;
+            size_t pos;
+
+            iterator() : bits(nullptr), pos(0) {}
+
+            iterator(word *bits, size_t pos) : bits(bits), pos(pos) {}
+
+            iterator operator+(difference_type n) const {
+                return iterator(bits, pos + n);
+            }
+
+            friend iterator operator+(difference_type n, const iterator &it) {
+                return iterator(it.bits, it.pos + n);
+            }
+
+            iterator operator-(difference_type n) const {
+                return iterator(bits, pos - n);
+            }
+
+            difference_type operator-(const iterator &rhs) const {
+                return difference_type(pos) - difference_type(rhs.pos);
+            }
+
+            iterator &operator+=(difference_type n) {
+                pos += n;
+                return *this;
+            }
+
+            iterator &operator-=(difference_type n) {
+                pos -= n;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator tmp = *this;
+                pos++;
+                return tmp;
+            }
+
+            iterator &operator++() {
+                pos++;
+                return *this;
+            }
+
+            iterator operator--(int) {
+                iterator tmp = *this;
+                pos--;
+                return tmp;
+            }
+
+            iterator &operator--() {
+                pos--;
+                return *this;
+            }
+
+            reference operator*() const {
+                return reference(bits, pos);
+            }
+
+            reference operator[](difference_type n) const {
+                return reference(bits, pos + n);
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return pos == rhs.pos;
+            }
+
+            bool operator==(const const_iterator &rhs) const {
+                return pos == rhs.pos;
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return pos != rhs.pos;
+            }
+
+            bool operator!=(const const_iterator &rhs) const {
+                return pos != rhs.pos;
+            }
+
+            bool operator<(const iterator &rhs) const {
+                return pos < rhs.pos;
+            }
+
+            bool operator>(const iterator &rhs) const {
+                return pos > rhs.pos;
+            }
+
+            bool operator<=(const iterator &rhs) const {
+                return pos <= rhs.pos;
+            }
+
+            bool operator>=(const iterator &rhs) const {
+                return pos >= rhs.pos;
+            }
+        };
+
+        class const_iterator {
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = bool;
+            using pointer = void;
+            using reference = bool;
+            using iterator_category = std::random_access_iterator_tag;
+
+            const word *bits;
+            size_t pos;
+
+            const_iterator() : bits(nullptr), pos(0) {}
+
+            const_iterator(const word *bits, size_t pos) : bits(bits), pos(pos) {}
+
+            const_iterator(const iterator &it) : bits(it.bits), pos(it.pos) {}
+
+            const_iterator operator+(difference_type n) const {
+                return const_iterator(bits, pos + n);
+            }
+
+            friend const_iterator operator+(difference_type n, const const_iterator &it) {
+                return const_iterator(it.bits, it.pos + n);
+            }
+
+            const_iterator operator-(difference_type n) const {
+                return const_iterator(bits, pos - n);
+            }
+
+            difference_type operator-(const const_iterator &rhs) const {
+                return difference_type(pos) - difference_type(rhs.pos);
+            }
+
+            const_iterator &operator+=(difference_type n) {
+                pos += n;
+                return *this;
+            }
+
+            const_iterator &operator-=(difference_type n) {
+                pos -= n;
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator tmp = *this;
+                pos++;
+                return tmp;
+            }
+
+            const_iterator &operator++() {
+                pos++;
+                return *this;
+            }
+
+            const_iterator operator--(int) {
+                const_iterator tmp = *this;
+                pos--;
+                return tmp;
+            }
+
+            const_iterator &operator--() {
+                pos--;
+                return *this;
+            }
+
+            bool operator*() const {
+                return (bits[pos / wordBits] >> pos % wordBits & 1) != 0;
+            }
+
+            bool operator[](difference_type n) const {
+                return *(*this + n);
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return pos == rhs.pos;
+            }
+
+            bool operator==(const const_iterator &rhs) const {
+                return pos == rhs.pos;
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return pos != rhs.pos;
+            }
+
+            bool operator!=(const const_iterator &rhs) const {
+                return pos != rhs.pos;
+            }
+
+            bool operator<(const const_iterator &rhs) const {
+                return pos < rhs.pos;
+            }
+
+            bool operator>(const const_iterator &rhs) const {
+                return pos > rhs.pos;
+            }
+
+            bool operator<=(const const_iterator &rhs) const {
+                return pos <= rhs.pos;
+            }
+
+            bool operator>=(const const_iterator &rhs) const {
+                return pos >= rhs.pos;
+            }
+        };
+
+        vector() : vector(Allocator()) {}
+
+        explicit vector(const Allocator &alloc)
+                : word_allocator(alloc), words(this->inlineBuf()), curLen(0), maxSiz(inlineBits) {
+            if constexpr (inlineWords != 0) std::memset(words, 0, inlineWords * sizeof(word));
+        }
+
+        vector(const vector &other) : vector(other.get_allocator()) {
+            if (other.curLen > inlineBits) {
+                words = allocate(wordsFor(other.curLen));
+                maxSiz = wordsFor(other.curLen) * wordBits;
+            }
+            if (other.curLen != 0) std::memcpy(words, other.words, wordsFor(other.curLen) * sizeof(word));
+            curLen = other.curLen;
+        }
+
+        /**
+         * steals the words of other in O(1); other is left empty.
+         */
+        vector(vector &&other) noexcept : vector(other.get_allocator()) {
+            takeFrom(other);
+        }
+
+        ~vector() {
+            release();
+        }
+
+        vector &operator=(const vector &other) {
+            if (this == &other) return *this;
+            vector tmp(other);
+            *this = std::move(tmp);
+            return *this;
+        }
+
+        vector &operator=(vector &&other) noexcept {
+            if (this == &other) return *this;
+            release();
+            resetInline();
+            takeFrom(other);
+            return *this;
+        }
+
+        void swap(vector &other) noexcept {
+            if (isSmall() || other.isSmall()) {
+                vector tmp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(tmp);
+                return;
+            }
+            word_allocator f0 = allocRef();
+            allocRef() = other.allocRef();
+            other.allocRef() = f0;
+            std::swap(words, other.words);
+            std::swap(curLen, other.curLen);
+            std::swap(maxSiz, other.maxSiz);
+        }
+
+        /**
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        reference at(const size_t &pos) {
+            if (pos >= size()) { throw index_out_of_bound(); }
+            return reference(words, pos);
+        }
+
+        bool at(const size_t &pos) const {
+            if (pos >= size()) { throw index_out_of_bound(); }
+            return test(pos);
+        }
+
+        reference operator[](const size_t &pos) {
+            return at(pos);
+        }
+
+        bool operator[](const size_t &pos) const {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        bool front() const {
+            if (empty()) { throw container_is_empty(); }
+            return test(0);
+        }
+
+        bool back() const {
+            if (empty()) { throw container_is_empty(); }
+            return test(curLen - 1);
+        }
+
+        iterator begin() {
+            return iterator(words, 0);
+        }
+
+        const_iterator begin() const {
+            return const_iterator(words, 0);
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(words, 0);
+        }
+
+        iterator end() {
+            return iterator(words, curLen);
+        }
+
+        const_iterator end() const {
+            return const_iterator(words, curLen);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(words, curLen);
+        }
+
+        /**
+         * the words holding the bits: element i is bit i % 64 of word i / 64.
+         * the bits past size() in the last word must stay zero.
+         */
+        word *data() {
+            return words;
+        }
+
+        const word *data() const {
+            return words;
+        }
+
+        bool empty() const {
+            return curLen == 0;
+        }
+
+        size_t size() const {
+            return curLen;
+        }
+
+        Allocator get_allocator() const {
+            return Allocator(allocRef());
+        }
+
+        /**
+         * the number of bits the words allocated so far can hold; a multiple of 64.
+         */
+        size_t capacity() const {
+            return maxSiz;
+        }
+
+        void reserve(size_t n) {
+            if (n > capacity()) relocate(n);
+        }
+
+        /**
+         * releases the words past the last one in use.
+         */
+        void shrink_to_fit() {
+            if (wordsFor(curLen) * wordBits < maxSiz) relocate(curLen);
+        }
+
+        /**
+         * removes every element and keeps the words for reuse.
+         */
+        void clear() {
+            if (curLen != 0) std::memset(words, 0, wordsFor(curLen) * sizeof(word));
+            curLen = 0;
+        }
+
+        /**
+         * the number of elements equal to value, counted a word at a time.
+         */
+        size_t count(bool value = true) const {
+            size_t ones = simd::popcount(words, wordsFor(curLen));
+            return value ? ones : curLen - ones;
+        }
+
+        /**
+         * the index of the first element equal to value at or after from, or size().
+         */
+        size_t find_first(bool value = true, size_t from = 0) const {
+            if (from >= curLen) return curLen;
+            word invert = value ? 0 : ~word(0);
+            size_t i = from / wordBits, last = wordsFor(curLen);
+            word w = (words[i] ^ invert) & ~word(0) << from % wordBits;
+            while (w == 0) {
+                if (++i == last) return curLen;
+                w = words[i] ^ invert;
+            }
+            // looking for zeros, the padding past size() reads as a match.
+            size_t pos = i * wordBits + size_t(__builtin_ctzll(w));
+            return pos < curLen ? pos : curLen;
+        }
+
+        /**
+         * sets every element to true.
+         */
+        void set() {
+            fillBits(0, curLen, true);
+        }
+
+        /**
+         * sets the elements in [first, last) to true.
+         * throw index_out_of_bound unless first <= last <= size
+         */
+        void set(size_t first, size_t last) {
+            if (first > last || last > curLen) throw index_out_of_bound();
+            fillBits(first, last, true);
+        }
+
+        /**
+         * sets every element to false.
+         */
+        void reset() {
+            fillBits(0, curLen, false);
+        }
+
+        /**
+         * sets the elements in [first, last) to false.
+         * throw index_out_of_bound unless first <= last <= size
+         */
+        void reset(size_t first, size_t last) {
+            if (first > last || last > curLen) throw index_out_of_bound();
+            fillBits(first, last, false);
+        }
+
+        /**
+         * negates every element.
+         */
+        void flip() {
+            size_t used = wordsFor(curLen);
+            for (size_t i = 0; i < used; ++i) words[i] = ~words[i];
+            clearPadding();
+        }
+
+        iterator insert(iterator pos, bool value) {
+            return insert(pos, 1, value);
+        }
+
+        template<typename... Args>
+        iterator emplace(iterator pos, Args &&...args) {
+            return insert(pos, 1, bool(std::forward<Args>(args)...));
+        }
+
+        /**
+         * throw index_out_of_bound if ind > size
+         */
+        iterator insert(const size_t &ind, bool value) {
+            if (ind > size()) throw index_out_of_bound();
+            return insert(begin() + ind, 1, value);
+        }
+
+        /**
+         * inserts count copies of value before pos; the tail is shifted a word at a time.
+         */
+        iterator insert(iterator pos, size_t count, bool value) {
+            size_t ind = pos.pos;
+            if (count == 0) return begin() + ind;
+            openGap(ind, count);
+            fillBits(ind, ind + count, value);
+            return begin() + ind;
+        }
+
+        /**
+         * inserts a copy of [first, last) before pos.
+         * first and last must be forward iterators that do not point into this vector.
+         */
+        template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        iterator insert(iterator pos, InputIt first, InputIt last) {
+            size_t ind = pos.pos;
+            size_t count = distance(first, last);
+            if (count == 0) return begin() + ind;
+            openGap(ind, count);
+            for (size_t i = ind; first != last; ++first, ++i) assign(i, bool(*first));
+            return begin() + ind;
+        }
+
+        /**
+         * replaces the contents with a copy of [first, last).
+         */
+        template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        void assign(InputIt first, InputIt last) {
+            size_t count = distance(first, last);
+            clear();
+            reserve(count);
+            for (size_t i = 0; first != last; ++first, ++i) {
+                if (*first) words[i / wordBits] |= word(1) << i % wordBits;
+            }
+            curLen = count;
+        }
+
+        iterator erase(iterator pos) {
+            return erase(pos, pos + 1);
+        }
+
+        /**
+         * throw index_out_of_bound if ind >= size
+         */
+        iterator erase(const size_t &ind) {
+            if (ind >= size()) throw index_out_of_bound();
+            return erase(begin() + ind);
+        }
+
+        /**
+         * removes the elements in [first, last); the tail is shifted a word at a time.
+         */
+        iterator erase(iterator first, iterator last) {
+            size_t ind = first.pos;
+            size_t count = last.pos - first.pos;
+            if (count == 0) return begin() + ind;
+            moveBits(ind, ind + count, curLen - ind - count);
+            fillBits(curLen - count, curLen, false);
+            curLen -= count;
+            reduceSpace();
+            return begin() + ind;
+        }
+
+        /**
+         * keeps only the elements for which keep(element) is true, preserving
+         * their order; see the primary template.
+         * returns the number of elements removed.
+         */
+        template<class Pred>
+        size_t retain(Pred keep) {
+            size_t w = 0, r = 0;
+            try {
+                for (; r < curLen; ++r) {
+                    bool x = test(r);
+                    if (keep(x)) assign(w++, x);
+                }
+            } catch (...) {
+                if (w != r) {
+                    moveBits(w, r, curLen - r);
+                    fillBits(curLen - (r - w), curLen, false);
+                    curLen -= r - w;
+                }
+                throw;
+            }
+            size_t removed = curLen - w;
+            fillBits(w, curLen, false);
+            curLen = w;
+            reduceSpace();
+            return removed;
+        }
+
+        void push_back(bool value) {
+            if (curLen == maxSiz) relocate(Growth::grow(curLen, curLen + 1));
+            if (value) words[curLen / wordBits] |= word(1) << curLen % wordBits;
+            curLen++;
+        }
+
+        template<typename... Args>
+        reference emplace_back(Args &&...args) {
+            push_back(bool(std::forward<Args>(args)...));
+            return reference(words, curLen - 1);
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back() {
+            if (empty()) { throw container_is_empty(); }
+            curLen--;
+            words[curLen / wordBits] &= ~(word(1) << curLen % wordBits);
+            reduceSpace();
+        }
+
+        void push_front(bool value) {
+            insert(begin(), 1, value);
+        }
+
+        template<typename... Args>
+        reference emplace_front(Args &&...args) {
+            insert(begin(), 1, bool(std::forward<Args>(args)...));
+            return reference(words, 0);
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_front() {
+            if (empty()) { throw container_is_empty(); }
+            erase(begin(), begin() + 1);
+        }
+
+        /**
+         * writes a binary snapshot to os: the header, then the words in use.
+         * throw runtime_error if os fails.
+         */
+        void save(std::ostream &os) const {
+            snapshot_header('B', 0, sizeof(word), curLen).save(os);
+            write_bytes(os, words, wordsFor(curLen) * sizeof(word));
+        }
+
+        /**
+         * replaces the elements with those of a snapshot written by save.
+         * throw runtime_error if is does not hold such a snapshot or ends
+         * early; the vector is left unchanged then.
+         */
+        void load(std::istream &is) {
+            size_t n = snapshot_count(is, snapshot_header::load(is, snapshot_header('B', 0, sizeof(word), 0)), 0);
+            // the capacity, a whole number of words, must still be counted in bits.
+            if (n > size_t(-1) - wordBits) throw runtime_error();
+            size_t cnt = snapshot_count(is, wordsFor(n), sizeof(word));
+            vector tmp(get_allocator());
+            // as for other elements: all at once if is could be checked, else in
+            // runs that at most double the buffer.
+            if (bytes_left(is) != size_t(-1)) tmp.reserve(n);
+            for (size_t done = 0; done < cnt;) {
+                size_t run = cnt - done;
+                size_t most = done > loadRun ? done : loadRun;
+                if (run > most) run = most;
+                tmp.reserve((done + run) * wordBits);
+                read_bytes(is, tmp.words + done, run * sizeof(word));
+                done += run;
+                tmp.curLen = done * wordBits < n ? done * wordBits : n;
+            }
+            tmp.clearPadding();
+            *this = std::move(tmp);
+        }
+
+    private:
+        word *words;
+        size_t curLen;
+        size_t maxSiz;
+
+        static size_t wordsFor(size_t bits) {
+            return bits / wordBits + (bits % wordBits != 0);
+        }
+
+        template<typename InputIt>
+        static size_t distance(InputIt first, InputIt last) {
+            size_t n = 0;
+            for (; first != last; ++first) ++n;
+            return n;
+        }
+
+        bool isSmall() {
+            return N != 0 && words == this->inlineBuf();
+        }
+
+        word_allocator &allocRef() {
+            return *this;
+        }
+
+        const word_allocator &allocRef() const {
+            return *this;
+        }
+
+        word *allocate(size_t n) {
+            return allocRef().allocate(n);
+        }
+
+        // frees the words unless they are the inline ones.
+        void release() {
+            if (words != this->inlineBuf()) allocRef().deallocate(words, maxSiz / wordBits);
+        }
+
+        // points the vector at its zeroed inline words; the old buffer must be released.
+        void resetInline() {
+            words = this->inlineBuf();
+            curLen = 0;
+            maxSiz = inlineBits;
+            if constexpr (inlineWords != 0) std::memset(words, 0, inlineWords * sizeof(word));
+        }
+
+        // moves the contents of other into *this, which must be empty and inline.
+        void takeFrom(vector &other) {
+            allocRef() = other.allocRef();
+            if (other.isSmall()) {
+                if constexpr (inlineWords != 0) std::memcpy(words, other.words, inlineWords * sizeof(word));
+                curLen = other.curLen;
+                other.resetInline();
+                return;
+            }
+            words = other.words;
+            curLen = other.curLen;
+            maxSiz = other.maxSiz;
+            other.resetInline();
+        }
+
+        /**
+         * moves the words into a buffer of at least n bits and releases the old
+         * one; the words past the ones in use are zeroed. n <= inlineBits selects
+         * the inline words.
+         */
+        void relocate(size_t n) {
+            size_t cnt = n <= inlineBits ? inlineWords : wordsFor(n);
+            word *tmp = n <= inlineBits ? this->inlineBuf() : allocate(cnt);
+            if (tmp == words) return;
+            size_t used = wordsFor(curLen);
+            if (used != 0) std::memcpy(tmp, words, used * sizeof(word));
+            if (cnt > used) std::memset(tmp + used, 0, (cnt - used) * sizeof(word));
+            release();
+            words = tmp;
+            maxSiz = cnt * wordBits;
+        }
+
+        // applies the shrink policy as often as it allows, but reallocates only once.
+        void reduceSpace() {
+            size_t n = maxSiz, m;
+            while ((m = Growth::shrink(n, curLen)) < n) n = m;
+            if (n < maxSiz && wordsFor(n) < maxSiz / wordBits) relocate(n);
+        }
+
+        bool test(size_t pos) const {
+            return (words[pos / wordBits] >> pos % wordBits & 1) != 0;
+        }
+
+        void assign(size_t pos, bool value) {
+            reference(words, pos) = value;
+        }
+
+        // zeroes the bits of the last word past size().
+        void clearPadding() {
+            if (curLen % wordBits != 0) words[curLen / wordBits] &= (word(1) << curLen % wordBits) - 1;
+        }
+
+        // the n <= 64 bits starting at pos, in the low bits of the result.
+        word getBits(size_t pos, size_t n) const {
+            size_t i = pos / wordBits, off = pos % wordBits;
+            word r = words[i] >> off;
+            if (off + n > wordBits) r |= words[i + 1] << (wordBits - off);
+            return n == wordBits ? r : r & ((word(1) << n) - 1);
+        }
+
+        // overwrites the n <= 64 bits starting at pos with the low bits of value.
+        void putBits(size_t pos, size_t n, word value) {
+            size_t i = pos / wordBits, off = pos % wordBits;
+            word m = n == wordBits ? ~word(0) : (word(1) << n) - 1;
+            value &= m;
+            words[i] = (words[i] & ~(m << off)) | value << off;
+            if (off + n > wordBits) {
+                size_t done = wordBits - off;
+                words[i + 1] = (words[i + 1] & ~(m >> done)) | value >> done;
+            }
+        }
+
+        // copies the len bits at src to dest, which may overlap them, 64 bits at a time.
+        void moveBits(size_t dest, size_t src, size_t len) {
+            if (dest < src) {
+                for (size_t k = 0; k < len; k += wordBits) {
+                    size_t n = len - k < wordBits ? len - k : wordBits;
+                    putBits(dest + k, n, getBits(src + k, n));
+                }
+            } else if (dest > src) {
+                for (size_t k = len; k > 0;) {
+                    size_t n = k < wordBits ? k : wordBits;
+                    k -= n;
+                    putBits(dest + k, n, getBits(src + k, n));
+                }
+            }
+        }
+
+        // sets the bits in [first, last) to value, whole words in between at once.
+        void fillBits(size_t first, size_t last, bool value) {
+            if (first >= last) return;
+            size_t i = first / wordBits, j = (last - 1) / wordBits;
+            word head = ~word(0) << first % wordBits;
+            word tail = ~word(0) >> (wordBits - 1 - (last - 1) % wordBits);
+            if (i == j) {
+                setMask(words[i], head & tail, value);
+                return;
+            }
+            setMask(words[i], head, value);
+            simd::fill<word>(words + i + 1, words + j, value ? ~word(0) : word(0));
+            setMask(words[j], tail, value);
+        }
+
+        static void setMask(word &w, word m, bool value) {
+            w = value ? w | m : w & ~m;
+        }
+
+        // makes room for count bits at ind by growing if needed and shifting the tail up.
+        void openGap(size_t ind, size_t count) {
+            if (curLen + count > maxSiz) relocate(Growth::grow(curLen, curLen + count));
+            moveBits(ind + count, ind, curLen - ind);
+            curLen += count;
+        }
+    };
+
+    template<class Growth, size_t N, class Allocator, class Pred>
+    size_t erase_if(vector<bool, Growth, N, Allocator> &v, Pred pred) {
+        return v.retain([&pred](bool x) { return !pred(x); });
+    }
+
+    template<class Growth, size_t N, class Allocator>
+    typename vector<bool, Growth, N, Allocator>::iterator find(vector<bool, Growth, N, Allocator> &v, const bool &value) {
+        return v.begin() + v.find_first(value);
+    }
+
+    template<class Growth, size_t N, class Allocator>
+    typename vector<bool, Growth, N, Allocator>::const_iterator find(const vector<bool, Growth, N, Allocator> &v, const bool &value) {
+        return v.cbegin() + v.find_first(value);
+    }
+
+    template<class Growth, size_t N, class Allocator>
+    size_t count(const vector<bool, Growth, N, Allocator> &v, const bool &value) {
+        return v.count(value);
+    }
+
+    template<class Growth, size_t N, class Allocator>
+    void fill(vector<bool, Growth, N, Allocator> &v, const bool &value) {
+        if (value) {
+            v.set();
+        } else {
+            v.reset();
+        }
+    }
+
+    /**
+     * compares whole words: the bits past size() are zero on both sides.
+     */
+    template<class G1, size_t N1, class A1, class G2, size_t N2, class A2>
+    bool operator==(const vector<bool, G1, N1, A1> &lhs, const vector<bool, G2, N2, A2> &rhs) {
+        return lhs.size() == rhs.size() && simd::equal<std::uint64_t>(lhs.data(), rhs.data(), (lhs.size() + 63) / 64);
+    }
+
+    template<class G1, size_t N1, class A1, class G2, size_t N2, class A2>
+    bool operator!=(const vector<bool, G1, N1, A1> &lhs, const vector<bool, G2, N2, A2> &rhs) {
+        return !(lhs == rhs);
+    }
+}
+
+#endif